@@ -41,13 +41,14 @@
  * 01.05	HVE/05-Mar-2018	Added trigonometic functions for complex arguments
  * 01.06	HVE/07-Jul-2019	Included iostream header for increased portability
  * 01.07	HVE/22-Mar-2021 Updated License Info
+ * 01.08	MBG/18-Oct-2026	Added sqr_add() for z=z*z+c in place with two squares and one multiply
  *
  * End of Change Record
  * --------------------------------------------------------------------------
 */
 
 /* define version string */
-static char _VC_[] = "@(#)complexprecision.h 01.07 -- Copyright (C) Henrik Vestermark";
+static char _VC_[] = "@(#)complexprecision.h 01.08 -- Copyright (C) Henrik Vestermark";
 
 #include <iostream>
 
@@ -95,6 +96,10 @@ template<class _Ty> class complex_precision {
       complex_precision<_Ty>& operator-=( const complex_precision<_Ty>& x )   { re -= x.real(); im -= x.imag(); return *this; }
       complex_precision<_Ty>& operator*=( const complex_precision<_Ty>& x )   { _Ty w(x.real()); w = re * x.real() - im * x.imag(); im = re * x.imag() + im * x.real(); re = w; return *this; }
       complex_precision<_Ty>& operator/=( const complex_precision<_Ty>& x );  // Too big to have here
+
+      // Fused z=z*z+c. rr and ii are re*re and im*im, e.g. from the last norm() test, and updated to those of the result
+      complex_precision<_Ty>& sqr_add( const complex_precision<_Ty>& c, _Ty& rr, _Ty& ii )
+                       { im *= re; im += im; im += c.imag(); re = rr; re -= ii; re += c.real(); rr = re; rr *= re; ii = im; ii *= im; return *this; }
      
 	  class divide_by_zero {};
    };
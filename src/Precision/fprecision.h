@@ -84,13 +84,20 @@
  * 02.02	HVE/10-Jan-2020 Corrected the extern declaration of float_precision_ctrl
  * 02.03	HVE/12-Aug-2020	Change precision type from unsinged int to size_t to enable both 32 and 64b it target.
  * 02.04	HVE/22-Mar-2021 Fix an negative sign issue for -0, should return 0 for the float_precision::.toFixed() method
+ * 02.05	MBG/18-Oct-2026	*= multiply mantissas packed into binary limbs below F_LIMBS_THRESHOLD digits when built with APML_LIMBS
+ * 02.06	MBG/18-Oct-2026	Added move constructor and move assignment. +=, -= and *= reuse the mantissa instead of copying it
+ *							and the arithmetic operators take over a temporary left hand side
+ * 02.07	MBG/18-Oct-2026	Mantissa buffers of F_BUFFER_DIGITS capacity are recycled per thread when built with APML_BUFFERS
+ * 02.08	MBG/18-Oct-2026	float_precision_ctrl is per thread. Added float_precision_scope to set it for a block
+ * 02.09	MBG/18-Oct-2026	*= squares equal mantissas with _float_precision_usqr_limbs() or _float_precision_usqr_fourier()
+ * 02.10	MBG/18-Oct-2026	*= switches to FFT at _float_precision_umul_thresholds.fourier digits, which _float_precision_tune_umul() measures
  *
  * End of Change Record
  * --------------------------------------------------------------------------
 */
 
 /* define version string */
-static char _VF_[] = "@(#)fprecision.h 02.04 -- Copyright (C) Henrik Vestermark";
+static char _VF_[] = "@(#)fprecision.h 02.10 -- Copyright (C) Henrik Vestermark";
 
 #include <algorithm>
 #include "iprecision.h"
@@ -116,6 +123,11 @@ inline unsigned char FDIGIT( char x )			{ return F_RADIX <= 10 ? (unsigned char)
 inline unsigned char FCHARACTER( char x )		{ return F_RADIX <= 10 ? (unsigned char)( x + '0') : (unsigned char)x; }
 inline unsigned char FCHARACTER10( char x)		{ return (unsigned char)( x + '0'); }
 
+// Default crossovers in digits of the shorter operand, where the binary limbs are multiplied with Toom-3
+// instead of the schoolbook method and where *= uses FFT instead of the limbs when built with APML_LIMBS
+static const size_t F_TOOM3_THRESHOLD = 450;
+static const size_t F_LIMBS_THRESHOLD = 4000;
+
 inline int FCARRY( unsigned int x )				{ return (int)( x / F_RADIX ); }
 inline int FSINGLE( unsigned int x )			{ return (int)( x % F_RADIX ); }
 
@@ -141,6 +153,8 @@ inline int digits_to_check() { if (F_RADIX == BASE_10) return 18; if(F_RADIX ==
 ///   rounding mode has explicit been specified.
 ///   Default precision is the manifest constant PRECISION
 ///   Default rounding mode is ROUND_NEAR (round to nearest)
+///   Each thread has its own float_precision_ctrl, so threads can calculate
+///   at different precisions. A new thread starts with the defaults
 //
 class float_precision_ctrl {
    enum round_mode   mRmode;  // Global Rounding mode. Default Round Nearest
@@ -148,7 +162,7 @@ class float_precision_ctrl {
 
    public:
       // Constructor
-      float_precision_ctrl( unsigned int p=PRECISION, enum round_mode rm=ROUND_NEAR ): mRmode(rm), mPrec(p) {}
+      constexpr float_precision_ctrl( unsigned int p=PRECISION, enum round_mode rm=ROUND_NEAR ): mRmode(rm), mPrec(p) {}
 
       // Coordinate functions
       enum round_mode mode() const              { return mRmode; }
@@ -157,12 +171,42 @@ class float_precision_ctrl {
       size_t precision( unsigned int p )        { mPrec = p > 0 ? p : PRECISION; return mPrec; }
    };
 
-extern class float_precision_ctrl float_precision_ctrl;
+extern thread_local class float_precision_ctrl float_precision_ctrl;
+
+///
+/// @class float_precision_scope
+/// @author Mandelbrot-Gempyre
+/// @date  18/Oct/2026
+/// @version 1.0
+/// @brief  Precision and round mode of the current thread for a block
+///
+/// @todo
+///
+///// Float Precision scope class
+///   Set float_precision_ctrl of the calling thread and restore the previous
+///   settings when the scope ends. E.g. a worker thread takes the settings of
+///   the thread that started it
+//
+class float_precision_scope {
+   class float_precision_ctrl mSaved;
+
+   public:
+      float_precision_scope( size_t p, enum round_mode rm=ROUND_NEAR ): mSaved( float_precision_ctrl )
+         {
+         float_precision_ctrl.precision( (unsigned int)p );
+         float_precision_ctrl.mode( rm );
+         }
+      ~float_precision_scope()					{ float_precision_ctrl = mSaved; }
+
+      float_precision_scope( const float_precision_scope& ) = delete;
+      float_precision_scope& operator=( const float_precision_scope& ) = delete;
+   };
 
 class float_precision;
 
 // Arithmetic + Binary and Unary
 template <class _Ty> inline float_precision operator+( float_precision&, const _Ty& );
+inline float_precision operator+( float_precision&&, const float_precision& );				// Reuse a temporary
 template <class _Ty> inline float_precision operator+( const _Ty&, const float_precision& );
 inline float_precision operator+( int_precision&, float_precision& );					// Override int_precision - other type in iprecision.h
 //inline float_precision operator+( float_precision&,int_precision&);					// Override int_precision - other type in iprecision.h
@@ -170,17 +214,20 @@ inline float_precision operator+( const float_precision& );								// Unary
 
 // Arithmetic - Binary and Unary
 template <class _Ty> inline float_precision operator-(float_precision&, const _Ty&);
+inline float_precision operator-(float_precision&&, const float_precision&);				// Reuse a temporary
 template <class _Ty> inline float_precision operator-(const _Ty&, const float_precision&);
 inline float_precision operator-(int_precision&, float_precision&);						// Override int_precision - other type in iprecision.h
 inline float_precision operator-( const float_precision& );								// Unary
 
 // Arithmetic * Binary
 template <class _Ty> inline float_precision operator*(float_precision&, const _Ty&);
+inline float_precision operator*(float_precision&&, const float_precision&);				// Reuse a temporary
 template <class _Ty> inline float_precision operator*(const _Ty&, const float_precision&);
 inline float_precision operator*(int_precision&, float_precision&);						// Override int_precision * other type in iprecision.h
 
 // Arithmetic / Binary
 template <class _Ty> inline float_precision operator/(float_precision&, const _Ty&);
+inline float_precision operator/(float_precision&&, const float_precision&);				// Reuse a temporary
 template <class _Ty> inline float_precision operator/(const _Ty&, const float_precision&);
 inline float_precision operator/(int_precision&, float_precision&);						// Override int_precision / other type in iprecision.h
 
@@ -255,10 +302,34 @@ std::string _float_precision_usub( int *, std::string *, std::string * );
 std::string _float_precision_umul_short( std::string *, unsigned int );
 std::string _float_precision_umul( std::string *, std::string * );
 std::string _float_precision_umul_fourier( std::string *, std::string * );
+std::string _float_precision_umul_limbs( std::string *, std::string * );
+std::string _float_precision_usqr_fourier( std::string * );
+std::string _float_precision_usqr_limbs( std::string * );
+
+// Crossovers of the multiplication in use. They are the defaults until _float_precision_tune_umul()
+// measures them on this CPU, tune before starting threads as they are shared and read without locking
+struct float_precision_umul_thresholds
+	{
+	size_t toom3;	// Shorter operand digits from which the limbs are multiplied with Toom-3
+	size_t fourier;	// Shorter operand digits from which *= uses FFT
+	};
+extern float_precision_umul_thresholds _float_precision_umul_thresholds;
+float_precision_umul_thresholds _float_precision_tune_umul();
 std::string _float_precision_udiv_short( unsigned int *, std::string *, unsigned int );
 std::string _float_precision_udiv( std::string *, std::string * );
 std::string _float_precision_urem( std::string *, std::string * );
 
+#if defined(APML_BUFFERS)
+// Capacity of the mantissa buffers that are recycled per thread. Arithmetic on mantissas
+// that fit does not allocate once the buffers of the thread are in use
+static const size_t F_BUFFER_DIGITS = 256;
+std::string _float_precision_buffer();
+void _float_precision_recycle( std::string * );
+#else
+inline std::string _float_precision_buffer()				{ return std::string(); }
+inline void _float_precision_recycle( std::string * )		{}
+#endif
+
 ///
 /// @class float_precision
 /// @author Henrik Vestermark (hve@hvks.com)
@@ -306,8 +377,10 @@ class float_precision {
       float_precision( double,size_t, enum round_mode );			// When initialized through a double
       float_precision( const char *, size_t, enum round_mode );		// When initialized through a char string
 	  float_precision( const std::string&, size_t, enum round_mode);// When initialized through a std::string
-      float_precision( const float_precision& s ): mNumber(s.mNumber), mRmode(s.mRmode), mPrec(s.mPrec), mExpo(s.mExpo), mSign(s.mSign) {}  // When initialized through another float_precision
+      float_precision( const float_precision& s ): mRmode(s.mRmode), mPrec(s.mPrec), mExpo(s.mExpo), mNumber(_float_precision_buffer()), mSign(s.mSign) { mNumber = s.mNumber; }  // When initialized through another float_precision
+      float_precision( float_precision&& s ) noexcept : mRmode(s.mRmode), mPrec(s.mPrec), mExpo(s.mExpo), mNumber(std::move(s.mNumber)), mSign(s.mSign) {}  // When initialized through a temporary float_precision
       float_precision( const int_precision&, size_t, enum round_mode );
+      ~float_precision()						{ _float_precision_recycle( &mNumber ); }
 
       // Coordinate functions
       std::string get_mantissa() const          { return mNumber.substr(); };    // Copy of mantissa
@@ -354,6 +427,7 @@ class float_precision {
 
       // Essential operators
       float_precision& operator= ( const float_precision& );
+      float_precision& operator= ( float_precision&& );
       float_precision& operator+=( const float_precision& );
       float_precision& operator-=( const float_precision& );
       float_precision& operator*=( const float_precision& );
@@ -371,6 +445,9 @@ class float_precision {
       class divide_by_zero		{};
       class domain_error		{};
       class base_error			{};
+
+   private:
+      float_precision& add( const float_precision&, int );	// += with the sign of the operand given
    };
 
 
@@ -1064,7 +1141,35 @@ inline float_precision& float_precision::operator=( const float_precision& a )
    {
    mExpo = a.mExpo;
    mSign = a.mSign;
-   mNumber = a.mNumber.substr();
+   if( mNumber.capacity() < a.mNumber.length() )
+      {
+      std::string b = _float_precision_buffer();
+      mNumber.swap( b );
+      }
+   mNumber = a.mNumber;  // Reuse the buffer of the mantissa
+   if( _float_precision_rounding( &mNumber, mSign, mPrec, mRmode ) != 0 )  // Round back to left hand side precision
+      mExpo++;
+
+   return *this;
+   }
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	= float precision numbers
+///	@return 	the resulting float_precision number
+///	@param   "a"	-	temporary float precsion number to assign
+///
+///	@todo
+///
+/// Description:
+///   Move assign operator
+///   Same as the assign operator but the mantissa is taken over from a
+//
+inline float_precision& float_precision::operator=( float_precision&& a )
+   {
+   mExpo = a.mExpo;
+   mSign = a.mSign;
+   mNumber.swap( a.mNumber );
    if( _float_precision_rounding( &mNumber, mSign, mPrec, mRmode ) != 0 )  // Round back to left hand side precision
       mExpo++;
 
@@ -1096,7 +1201,25 @@ inline float_precision& float_precision::operator=( const float_precision& a )
 //
 inline float_precision& float_precision::operator+=( const float_precision& a )
 	{
-	int sign, sign1, sign2, wrap;
+	return add( a, a.mSign );
+	}
+
+///	@author Henrik Vestermark (hve@hvks.com)
+///	@date  1/21/2005
+///	@brief 	add float precision numbers
+///	@return 	the resulting float_precision number
+///	@param   "a"	-	float precsion number to add
+///	@param   "sign1"	-	sign of a to use, -a.sign() subtracts
+///
+///	@todo
+///
+/// Description:
+///   The body of += and -=, so that -= needs no negated copy of a
+///   The mantissa of this is reused for the sum
+//
+inline float_precision& float_precision::add( const float_precision& a, int sign1 )
+	{
+	int sign, sign2, wrap;
 	int expo_max, digits_max;
 	size_t precision_max;
 	std::string s, s1, s2;
@@ -1104,13 +1227,17 @@ inline float_precision& float_precision::operator+=( const float_precision& a )
 	if( a.mNumber.length() == 1 && FDIGIT( a.mNumber[0] ) == 0 )  // Add zero
 		return *this;
 	if( mNumber.length() == 1 && FDIGIT( mNumber[0] ) == 0 )      // Add a (not zero) to *this (is zero) Same as *this = a;
-		return *this = a;
+		{
+		*this = a;
+		mSign = sign1;
+		return *this;
+		}
 
 	// extract sign and unsigned portion of number
-	sign1 = a.mSign;
-	s1 = a.mNumber.substr();		// Extract Mantissa
+	s1 = _float_precision_buffer();
+	s1 = a.mNumber;					// Extract Mantissa, before this is taken as a may be this
 	sign2 = mSign;
-	s2 = mNumber.substr();			// Extract Mantissa
+	s2 = std::move( mNumber );		// Extract Mantissa
 	expo_max = std::max( mExpo, a.mExpo );
 	precision_max = std::max( mPrec, a.mPrec );
 
@@ -1171,8 +1298,10 @@ inline float_precision& float_precision::operator+=( const float_precision& a )
 		expo_max++;
 
 	mSign = sign;
-	mNumber = s;
+	mNumber = std::move( s );
 	mExpo = expo_max;
+	_float_precision_recycle( &s1 );
+	_float_precision_recycle( &s2 );
 
 	return *this;
 	}
@@ -1191,15 +1320,7 @@ inline float_precision& float_precision::operator+=( const float_precision& a )
 //
 inline float_precision& float_precision::operator-=( const float_precision& a )
 	{
-	float_precision b;
-
-	b.precision( a.precision() );
-	b.mode( a.mode() );
-	b = a;
-	b.change_sign();
-	*this += b;
-
-	return *this;
+	return add( a, -a.mSign );
 	}
 
 ///	@author Henrik Vestermark (hve@hvks.com)
@@ -1221,25 +1342,38 @@ inline float_precision& float_precision::operator*=( const float_precision& a )
 	{
 	int expo_res;
 	int sign, sign1, sign2;
-	std::string s, s1, s2;
+	std::string s, *s1, *s2;
 
-	// extract sign and unsigned portion of number
+	// extract sign and unsigned portion of number, the mantissas are only read
 	sign1 = a.mSign;
-	s1 = a.mNumber.substr();
+	s1 = const_cast<std::string *>( &a.mNumber );
 	sign2 = mSign;
-	s2 = mNumber.substr();
+	s2 = &mNumber;
 
 	sign = sign1 * sign2;
 	// Check for multiplication of 1 digit and use umul_short().
-	if(s1.length()==1 )
-		s = _float_precision_umul_short( &s2, FDIGIT(s1[0]));
+	if(s1->length()==1 )
+		s = _float_precision_umul_short( s2, FDIGIT((*s1)[0]));
 	else
-		if( s2.length()==1)
-			s=_float_precision_umul_short( &s1, FDIGIT(s2[0]));
+		if( s2->length()==1)
+			s=_float_precision_umul_short( s1, FDIGIT((*s2)[0]));
 		else
-			s = _float_precision_umul_fourier( &s1, &s2 );
+			if( s1 == s2 || *s1 == *s2 )  // x*=x or equal mantissas, use the square routines
+#if defined(APML_LIMBS)
+				if( s1->length() < _float_precision_umul_thresholds.fourier )
+					s = _float_precision_usqr_limbs( s1 );
+				else
+#endif
+				s = _float_precision_usqr_fourier( s1 );
+			else
+#if defined(APML_LIMBS)
+				if( std::min( s1->length(), s2->length() ) < _float_precision_umul_thresholds.fourier )
+					s = _float_precision_umul_limbs( s1, s2 );
+				else
+#endif
+				s = _float_precision_umul_fourier( s1, s2 );
 	expo_res = mExpo + a.mExpo;
-	if( s.length() -1 > s1.length() + s2.length() -2 ) // A carry
+	if( s.length() -1 > s1->length() + s2->length() -2 ) // A carry
 		expo_res++;
 	expo_res += _float_precision_normalize( &s );            // Normalize the number
 	if( _float_precision_rounding( &s, sign, mPrec, mRmode ) != 0 )  // Round back left hand side precision
@@ -1252,7 +1386,8 @@ inline float_precision& float_precision::operator*=( const float_precision& a )
 
 	mSign = sign;
 	mExpo = expo_res;
-	mNumber = s;
+	mNumber.swap( s );
+	_float_precision_recycle( &s );
 
 	return *this;
 	}
@@ -1345,7 +1480,8 @@ inline float_precision operator+( float_precision& lhs, float_precision& rhs)
 	if (lhs.precision() > c.precision())
 		c.precision(lhs.precision());
 
-	return c += lhs;
+	c += lhs;
+	return c;
 	}
 */
 
@@ -1369,7 +1505,8 @@ template <class _Ty> inline float_precision operator+( float_precision& lhs, con
 	if( lhs.precision() > c.precision() )
 		c.precision( lhs.precision() );
 
-	return c += lhs;
+	c += lhs;
+	return c;
 	}
 
 
@@ -1391,9 +1528,32 @@ template <class _Ty> inline float_precision operator+( const _Ty& lhs, const flo
 	if( rhs.precision() > c.precision() )
 		c.precision( rhs.precision() );
 
-	return c += rhs;
+	c += rhs;
+	return c;
+	}
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	add
+///	@return 	float_precision	-	return lhs + rhs
+///	@param   "lhs"	-	temporary float_precision that holds the result
+///	@param   "rhs"	-	Second operand
+///
+///	@todo
+///
+/// Description:
+///   Binary add of a temporary, e.g. a*b + c. lhs is reused instead of copied
+//
+inline float_precision operator+( float_precision&& lhs, const float_precision& rhs )
+	{
+	if( lhs.precision() < rhs.precision() )
+		lhs.precision( rhs.precision() );
+
+	lhs += rhs;
+	return std::move( lhs );
 	}
 
+
 ///   @author Henrik Vestermark (hve@hvks.com)
 ///   @date  3/19/2006
 ///   @version 1.0
@@ -1412,7 +1572,8 @@ inline float_precision operator+( int_precision& lhs, float_precision& rhs )
 	if( rhs.precision() > c.precision() )
 		c.precision( rhs.precision() );
 
-	return c += rhs;
+	c += rhs;
+	return c;
 	}
 
 
@@ -1434,7 +1595,8 @@ inline float_precision operator+( float_precision& lhs, int_precision& rhs )
 	if (lhs.precision() > c.precision())
 		c.precision(lhs.precision());
 
-	return c += lhs;
+	c += lhs;
+	return c;
 	}
 
 ///	@author Henrik Vestermark (hve@hvks.com)
@@ -1474,7 +1636,8 @@ template <class _Ty> inline float_precision operator-( float_precision& lhs, con
 	if (d.precision() < c.precision())
 		d.precision(c.precision());
 
-	return d -= c;
+	d -= c;
+	return d;
 	}
 
 ///	@author Henrik Vestermark (hve@hvks.com)
@@ -1497,9 +1660,32 @@ template <class _Ty> inline float_precision operator-( const _Ty& lhs, const flo
 	if (d.precision() < c.precision())
 		d.precision(c.precision());
 
-	return d -= c;
+	d -= c;
+	return d;
 	}
 
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	subtract
+///	@return 	float_precision	-	return lhs - rhs
+///	@param   "lhs"	-	temporary float_precision that holds the result
+///	@param   "rhs"	-	Second operand
+///
+///	@todo
+///
+/// Description:
+///   Binary subtract of a temporary, e.g. a*b - c. lhs is reused instead of copied
+//
+inline float_precision operator-( float_precision&& lhs, const float_precision& rhs )
+	{
+	if( lhs.precision() < rhs.precision() )
+		lhs.precision( rhs.precision() );
+
+	lhs -= rhs;
+	return std::move( lhs );
+	}
+
+
 ///   @author Henrik Vestermark (hve@hvks.com)
 ///   @date  7/29/2014
 ///   @version 1.0
@@ -1518,7 +1704,8 @@ inline float_precision operator-(int_precision& lhs, float_precision& rhs)
 	if (rhs.precision() > c.precision())
 		c.precision(rhs.precision());
 
-	return c -= rhs;
+	c -= rhs;
+	return c;
 	}
 
 
@@ -1595,7 +1782,8 @@ template <class _Ty> inline float_precision operator*(float_precision& lhs, cons
 	if (lhs.precision() > c.precision())
 		c.precision(lhs.precision());
 
-	return c *= lhs;
+	c *= lhs;
+	return c;
 	}
 
 ///	@author Henrik Vestermark (hve@hvks.com)
@@ -1618,9 +1806,32 @@ template <class _Ty> inline float_precision operator*( const _Ty&lhs, const floa
 	if (rhs.precision() > c.precision())
 		c.precision(rhs.precision());
 
-	return c *= rhs;
+	c *= rhs;
+	return c;
+	}
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	multiply
+///	@return 	float_precision	-	return lhs * rhs
+///	@param   "lhs"	-	temporary float_precision that holds the result
+///	@param   "rhs"	-	Second operand
+///
+///	@todo
+///
+/// Description:
+///   Binary multiply of a temporary, e.g. a*b * c. lhs is reused instead of copied
+//
+inline float_precision operator*( float_precision&& lhs, const float_precision& rhs )
+	{
+	if( lhs.precision() < rhs.precision() )
+		lhs.precision( rhs.precision() );
+
+	lhs *= rhs;
+	return std::move( lhs );
 	}
 
+
 ///   @author Henrik Vestermark (hve@hvks.com)
 ///   @date  7/29/2014
 ///   @version 1.0
@@ -1639,7 +1850,8 @@ inline float_precision operator*(int_precision& lhs, float_precision& rhs)
 	if (rhs.precision() > c.precision())
 		c.precision(rhs.precision());
 
-	return c *= rhs;
+	c *= rhs;
+	return c;
 	}
 
 
@@ -1695,7 +1907,8 @@ template <class _Ty> inline float_precision operator/(float_precision& lhs, cons
 	if (d.precision() < c.precision())
 		d.precision(c.precision());
 
-	return d /= c;
+	d /= c;
+	return d;
 	}
 
 ///	@author Henrik Vestermark (hve@hvks.com)
@@ -1718,9 +1931,32 @@ template <class _Ty> inline float_precision operator/(const _Ty& lhs, const floa
 	if (d.precision() < c.precision())
 		d.precision(c.precision());
 
-	return d /= c;
+	d /= c;
+	return d;
+	}
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	divide
+///	@return 	float_precision	-	return lhs / rhs
+///	@param   "lhs"	-	temporary float_precision that holds the result
+///	@param   "rhs"	-	Second operand
+///
+///	@todo
+///
+/// Description:
+///   Binary divide of a temporary, e.g. a*b / c. lhs is reused instead of copied
+//
+inline float_precision operator/( float_precision&& lhs, const float_precision& rhs )
+	{
+	if( lhs.precision() < rhs.precision() )
+		lhs.precision( rhs.precision() );
+
+	lhs /= rhs;
+	return std::move( lhs );
 	}
 
+
 ///   @author Henrik Vestermark (hve@hvks.com)
 ///   @date  7/29/2014
 ///   @version 1.0
@@ -1739,7 +1975,8 @@ inline float_precision operator/(int_precision& lhs, float_precision& rhs)
 	if (rhs.precision() > c.precision())
 		c.precision(rhs.precision());
 
-	return c /= rhs;
+	c /= rhs;
+	return c;
 	}
 
 
@@ -1795,7 +2032,8 @@ template <class _Ty> inline float_precision operator%(float_precision& lhs, cons
 	if (d.precision() < c.precision())
 		d.precision(c.precision());
 
-	return d %= c;
+	d %= c;
+	return d;
 	}
 
 ///	@author Henrik Vestermark (hve@hvks.com)
@@ -1818,7 +2056,8 @@ template <class _Ty> inline float_precision operator%(const _Ty& lhs, const floa
 	if (d.precision() < c.precision())
 		d.precision(c.precision());
 
-	return d %= c;
+	d %= c;
+	return d;
 	}
 
 ///   @author Henrik Vestermark (hve@hvks.com)
@@ -1839,7 +2078,8 @@ inline float_precision operator%(int_precision& lhs, float_precision& rhs)
 	if (rhs.precision() > c.precision())
 		c.precision(rhs.precision());
 
-	return c %= rhs;
+	c %= rhs;
+	return c;
 	}
 
 
@@ -98,13 +98,17 @@
  * 02.06	HVE/04-Oct-2020	Fixed an issue in the conversion operator for long and long long c-types
  * 02.07	HVE/24-Mar-2021 Updated license info
  * 02.08	HVE/5-Jul-2021	Replaced all deprecreated headers with current ones
+ * 02.09	MBG/18-Oct-2026	Added move constructor and move assignment. The binary operators return their result without a copy
+ * 02.10	MBG/18-Oct-2026	*= squares equal operands with _int_precision_usqr_fourier()
+ * 02.11	MBG/18-Oct-2026	Added NTT_THRESHOLD and NTT_MAX_SIZE for the number theoretic transform multiplication
+ * 02.12	MBG/18-Oct-2026	*= squares operands of up to twice the 64bit digits with _int_precision_karatsuba_usqr()
  *
  * End of Change Record
  * --------------------------------------------------------------------------
 */
 
 /* define version string */
-static char _VI_[] = "@(#)iprecision.h 02.08 -- Copyright (C) Henrik Vestermark";
+static char _VI_[] = "@(#)iprecision.h 02.12 -- Copyright (C) Henrik Vestermark";
 
 // If _INT_PRECESION_FAST_DIV_REM is defined it will use a magnitude faster div and rem integer operation.
 #define _INT_PRECISSION_FAST_DIV_REM
@@ -162,6 +166,8 @@ class precision_ctrl {
 extern class precision_ctrl precision_ctrl;
 
 static const int RADIX = BASE_10;			// Set internal base for the arbitrary precision
+static const size_t NTT_THRESHOLD = 1 << 20;	// Operand digits from which the fourier multiplications use the exact number theoretic transform
+static const size_t NTT_MAX_SIZE = 1 << 23;	// Largest number theoretic transform the primes allow
 
 inline std::string SIGN_STRING( int x )   { return x >=0 ? "+" : "-" ; }
 inline int CHAR_SIGN( char x )            { return x == '-' ? -1 : 1; }
@@ -225,6 +231,7 @@ extern int_precision lcm(const int_precision&, const int_precision&);
 
 // Core functions that works directly on String class and unsigned arithmetic
 void _int_real_fourier( double [], unsigned int, int );
+std::string _int_ntt_umul( const std::string *, const std::string *, const unsigned int );
 std::string _int_precision_uadd( std::string *, std::string *);
 std::string _int_precision_uadd_short( std::string *, unsigned int );
 std::string _int_precision_usub( int *, std::string *, std::string *);
@@ -233,7 +240,9 @@ std::string _int_precision_umul( std::string *, std::string *);
 std::string _int_precision_umul_short( std::string *, unsigned int );
 std::string _int_precision_umul64( std::string *, std::string * );
 std::string _int_precision_umul_fourier( std::string *, std::string *);
+std::string _int_precision_usqr_fourier( std::string * );
 std::string _int_precision_karatsuba_umul(const std::string *, const std::string *);
+std::string _int_precision_karatsuba_usqr(const std::string * );
 std::string _int_precision_schonhage_strassen_linear_umul(const std::string *, const std::string *);
 std::string _int_precision_udiv( std::string *, std::string *);
 std::string _int_precision_udiv_short( unsigned int *, std::string *, unsigned int );
@@ -295,6 +304,7 @@ class int_precision
 	//  int_precision( const int64_t );		// When initialized through a 64 bit int
 	//  int_precision( const uint64_t );		// When initialized through a 64 bit unsigned int
   	  int_precision( const int_precision& s ) : mSign(s.mSign), mNumber(s.mNumber) {}  // When initialized through another int_precision
+  	  int_precision( int_precision&& s ) noexcept : mSign(s.mSign), mNumber(std::move(s.mNumber)) {}  // When initialized through a temporary int_precision
 
       // Coordinate functions
 	  std::string copy(size_t pos = 0, size_t len = std::string::npos) const {return mNumber.substr(pos,len); }  // Same as the string.substr()
@@ -325,6 +335,7 @@ class int_precision
 
       // Essential operators
       int_precision& operator=( const int_precision& );
+      int_precision& operator=( int_precision&& );
       int_precision& operator+=( const int_precision& );
       int_precision& operator-=( const int_precision& );
       int_precision& operator*=( const int_precision& );
@@ -980,6 +991,24 @@ inline int_precision& int_precision::operator=( const int_precision& a )
 	return *this;
 	}
 
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	operator=
+///	@return 	int_precision&	-	return a =b
+///	@param   "a"	-	temporary to take over
+///
+///	@todo
+///
+/// Description:
+///   Move assign, the mantissa of a is taken over
+//
+inline int_precision& int_precision::operator=( int_precision&& a )
+	{
+	mNumber.swap( a.mNumber );
+	mSign = a.mSign;
+	return *this;
+	}
+
 ///	@author Henrik Vestermark (hve@hvks.com)
 ///	@date  1/19/2005
 ///	@brief 	operator+=
@@ -1122,8 +1151,16 @@ inline int_precision& int_precision::operator*=( const int_precision& a )
 		else  // Check for multiplication of of number that can safely be done using 64bit binary multiplication
 			if ((length <= 18 && BASE_10==RADIX) ||(length<=20 && BASE_8==RADIX) || (length <=64 && BASE_2==RADIX) || (length <=8 && BASE_256==RADIX ))
 				mNumber = _int_precision_umul64( &mNumber, (std::string *)&a.mNumber);
-			else // Use FFT for multiplication
-				mNumber =_int_precision_umul_fourier( &mNumber, (std::string *)&a.mNumber );
+			else // Use FFT for multiplication, a squaring needs only one transform
+				if( this == &a || mNumber == a.mNumber )
+					{// One karatsuba step brings the halves within 64bit multiplication, faster than the FFT
+					if ((length <= 36 && BASE_10==RADIX) ||(length<=40 && BASE_8==RADIX) || (length <=128 && BASE_2==RADIX) || (length <=16 && BASE_256==RADIX ))
+						mNumber = _int_precision_karatsuba_usqr( &mNumber );
+					else
+						mNumber = _int_precision_usqr_fourier( &mNumber );
+					}
+				else
+					mNumber =_int_precision_umul_fourier( &mNumber, (std::string *)&a.mNumber );
 
 	if (mSign == -1 && mNumber.length() == 1 && IDIGIT(mNumber[0]) == 0)  // Avoid -0 as result +0 is right
 		mSign = +1;
@@ -1560,7 +1597,10 @@ inline int_precision& int_precision::operator&=( const int_precision& a )
 ///
 template <class _Ty> inline int_precision operator+( int_precision& lhs, const _Ty& rhs )
 	{
-	return int_precision(lhs) += rhs;
+	int_precision c(lhs);
+
+	c += rhs;
+	return c;
 	}
 
 
@@ -1577,7 +1617,10 @@ template <class _Ty> inline int_precision operator+( int_precision& lhs, const _
 ///
 template <class _Ty> inline int_precision operator+( const _Ty& lhs, const int_precision& rhs )
 	{
-	return int_precision(lhs) += rhs;
+	int_precision c(lhs);
+
+	c += rhs;
+	return c;
 	}
 
 
@@ -1650,7 +1693,10 @@ inline int_precision operator++( int_precision& a, int )
 ///
 template <class _Ty> inline int_precision operator-( int_precision& lhs, const _Ty& rhs )
 	{
-	return int_precision(lhs) -= rhs;
+	int_precision c(lhs);
+
+	c -= rhs;
+	return c;
 	}
 
 
@@ -1667,7 +1713,10 @@ template <class _Ty> inline int_precision operator-( int_precision& lhs, const _
 ///
 template <class _Ty> inline int_precision operator-( const _Ty& lhs, const int_precision& rhs )
 	{
-	return int_precision(lhs) -= rhs;
+	int_precision c(lhs);
+
+	c -= rhs;
+	return c;
 	}
 
 
@@ -1743,7 +1792,10 @@ int_precision operator--( int_precision& a, int )
 ///
 template <class _Ty> inline int_precision operator*( int_precision& lhs, const _Ty& rhs )
 	{
-	return int_precision(lhs) *= rhs;
+	int_precision c(lhs);
+
+	c *= rhs;
+	return c;
 	}
 
 
@@ -1761,7 +1813,10 @@ template <class _Ty> inline int_precision operator*( int_precision& lhs, const _
 ///
 template <class _Ty> inline int_precision operator*( const _Ty& lhs, const int_precision& rhs )
 	{
-	return int_precision(lhs) *= rhs;
+	int_precision c(lhs);
+
+	c *= rhs;
+	return c;
 	}
 
 
@@ -1780,7 +1835,10 @@ template <class _Ty> inline int_precision operator*( const _Ty& lhs, const int_p
 ///
 template <class _Ty> inline int_precision operator/( int_precision& lhs, const _Ty& rhs )
 	{
-	return int_precision(lhs) /= rhs;
+	int_precision c(lhs);
+
+	c /= rhs;
+	return c;
 	}
 
 
@@ -1797,7 +1855,10 @@ template <class _Ty> inline int_precision operator/( int_precision& lhs, const _
 ///
 template <class _Ty> inline int_precision operator/( const _Ty& lhs, const int_precision& rhs )
 	{
-	return int_precision(lhs) /= rhs;
+	int_precision c(lhs);
+
+	c /= rhs;
+	return c;
 	}
 
 ///	@author Henrik Vestermark (hve@hvks.com)
@@ -1814,7 +1875,10 @@ template <class _Ty> inline int_precision operator/( const _Ty& lhs, const int_p
 ///
 template <class _Ty> inline int_precision operator%( int_precision& lhs, const _Ty& rhs )
 	{
-	return int_precision(lhs) %= rhs;
+	int_precision c(lhs);
+
+	c %= rhs;
+	return c;
 	}
 
 
@@ -1831,7 +1895,10 @@ template <class _Ty> inline int_precision operator%( int_precision& lhs, const _
 ///
 template <class _Ty> inline int_precision operator%( const _Ty& lhs, const int_precision& rhs )
 	{
-	return int_precision(lhs) %= rhs;
+	int_precision c(lhs);
+
+	c %= rhs;
+	return c;
 	}
 
 ///	@author Henrik Vestermark (hve@hvks.com)
@@ -99,13 +99,26 @@
  * 02.08	HVE/4-Jul-2021	Fixed an bug in umul_fourier where a variable was not initialized
  * 02.09	HVE/5-Jul-2021	Replaced all deprecreated headers with current ones. Fixed a bug in floor() and ceil() where exponent was handle as unsigned instead of signed
  * 02.10	HVE/29-Jul-2021	minor cosmetics changes making the code more portable to other environments
+ * 02.11	MBG/18-Oct-2026	Added _float_precision_umul_limbs() that multiply mantissas packed into binary limbs of several radix digits
+ * 02.12	MBG/18-Oct-2026	_float_precision_rounding() rounds up in place and _float_precision_umul_limbs() reuses its limbs between calls
+ * 02.13	MBG/18-Oct-2026	Added _float_precision_buffer() and _float_precision_recycle(). The add, subtract and multiply kernels
+ *							build their result in a recycled buffer
+ * 02.14	MBG/18-Oct-2026	float_precision_ctrl and the constants of _float_table() are per thread
+ * 02.15	MBG/18-Oct-2026	Added the squaring routines _float_precision_usqr_limbs(), _float_precision_usqr_fourier(),
+ *							_int_precision_usqr_fourier() and _int_precision_karatsuba_usqr()
+ * 02.16	MBG/18-Oct-2026	_int_fourier() and _int_real_fourier() use per thread twiddle tables and a sequential butterfly order.
+ *							Added the number theoretic transform _int_ntt_umul() for operands of NTT_THRESHOLD digits or more.
+ *							The fourier multiplications no longer leak their second array
+ * 02.17	MBG/18-Oct-2026	The limb multiplication and squaring use Toom-3 for long operands. Added _float_precision_tune_umul()
+ *							that measures the crossovers to Toom-3 and to FFT on the host CPU
+ * 02.18	MBG/18-Oct-2026	_float_precision_inverse() doubles the working precision of each Newton step like sqrt()
  *
  * End of Change Record
  * --------------------------------------------------------------------------
 */
 
 /* define version string */
-static char _VIP_[] = "@(#)precisioncore.cpp 02.09 -- Copyright (C) Henrik Vestermark";
+static char _VIP_[] = "@(#)precisioncore.cpp 02.18 -- Copyright (C) Henrik Vestermark";
 
 #include <cstdint>
 #include <ctime>
@@ -114,6 +127,8 @@ static char _VIP_[] = "@(#)precisioncore.cpp 02.09 -- Copyright (C) Henrik Veste
 #include <iomanip>
 #include <cstring>
 #include <vector>
+#include <chrono>
+#include <functional>
 #include <omp.h>
 
 using namespace std;
@@ -226,13 +241,15 @@ std::string _int_precision_itoa( int_precision *a )
 //    _int_reverse_binary        -- Reverse bit in the data buffer
 //    _int_fourier               -- Fourier transformn the data
 //    _int_real_fourier          -- Convert n discrete double data into a fourier transform data set
+//    _int_ntt                   -- Number theoretic transform of the data
+//    _int_ntt_umul              -- multiply two unsigned strings with the number theoretic transform
 //
 
 ///	@author Henrik Vestermark (hve@hvks.com)
 ///	@date  1/19/2005
 ///	@brief 	_int_reverse_binary
 ///	@return 	void	-	
-///	@param   "data[]"	-	array of double complex number to permute
+///	@param   "data[]"	-	array of double complex number or NTT residues to permute
 ///	@param   "n"	-	number of element in data[]
 ///
 ///	@todo  
@@ -241,7 +258,7 @@ std::string _int_precision_itoa( int_precision *a )
 ///   Reverse binary permute
 ///   n must be a power of 2
 //
-static void _int_reverse_binary( std::complex<double> data[], const size_t n )
+template<class _Ty> static void _int_reverse_binary( _Ty data[], const size_t n )
    {
    size_t i, j, m;
 
@@ -259,6 +276,34 @@ static void _int_reverse_binary( std::complex<double> data[], const size_t n )
       }
    }
 
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	_int_fourier_twiddles
+///	@return 	const std::complex<double> *	-	the twiddle table
+///	@param   "n"	-	largest transform size (a power of 2) the table must cover
+///
+///	@todo  
+///
+/// Description:
+///   Twiddle factors exp( 2*PI*i*j/m ), j=0..m/2-1 of each power of 2 m <= n are stored from index m/2,
+///   so a table serves every smaller transform too. The table of the thread only grows and is calculated once,
+///   each entry directly with sin() and cos() which is more accurate than the trigonometric recurrence.
+//
+static const std::complex<double> *_int_fourier_twiddles( const size_t n )
+   {
+   static thread_local std::vector<std::complex<double> > w;
+
+   if( w.size() < n )
+      {
+      size_t m = w.empty() ? 2 : 2 * w.size();
+      w.resize( n );
+      for( ; m <= n; m <<= 1 )
+         for( size_t j = 0; j < m / 2; ++j )
+            w[ m / 2 + j ] = std::polar( 1.0, 2 * 3.14159265358979323846264 * j / m );
+      }
+   return w.data();
+   }
+
 ///	@author Henrik Vestermark (hve@hvks.com)
 ///	@date  1/19/2005
 ///	@brief 	_int_fourier do the fourier transformation
@@ -271,40 +316,38 @@ static void _int_reverse_binary( std::complex<double> data[], const size_t n )
 ///
 /// Description:
 ///   Wk=exp(2* PI *i *j )  j=0..n/2-1
-///   exp( k * i *j ) => exp( k * i * (j-1) + k * i ) => exp( t + o ) for each new step
-///   exp( t + o ) => exp(t)-exp(t)*( 1 - cos(o) -isin(o) ) => exp(t)-exp(t)*(a-ib)
-///   => exp(t)+exp(t)*(-a+ib) => exp(t)( 1 + (-a+b) )
-///   sin(t+o)=sin(t)+[-a*sin(t)+b*cos(t)]
-///   a=2sin^2(o/2), b=sin(o)
+///   The twiddles are taken from _int_fourier_twiddles(), conjugated for the inverse transform.
+///   Each block of a stage is run through with the twiddles in order, the butterflies
+///   are written on the real and imaginary parts so that the compiler can vectorize them.
 ///   n must be a power of 2
 //
 static void _int_fourier( std::complex<double> data[], const size_t n, const int isign )
    {
-   double theta;
-   std::complex<double> w, wp;
-   size_t mh, m, r, j, i;
+   const std::complex<double> *twiddles = _int_fourier_twiddles( n );
+   double *d = reinterpret_cast<double *>( data );
+   const double s = isign;
+   size_t mh, m, r, j;
 
    _int_reverse_binary( data, n );
 
    for( m = 2; n >= m; m <<= 1 )
       {
-      theta = isign * 2 * 3.14159265358979323846264 / m;
-      wp = std::complex<double>( -2.0 * sin( 0.5 * theta ) * sin( 0.5 * theta ), sin( theta ) );
-      w = std::complex<double> ( 1, 0 ); // exp(0) == exp( isign*2*PI*i/mmax * m-1 )
+      const double *w = reinterpret_cast<const double *>( twiddles + ( m >> 1 ) );
       mh = m >> 1;
 
-      for( j = 0; j < mh; j++ )      // m/2 iteration
+      for( r = 0; r < n; r += m )
          {
-         for( r = 0; r <= n - m; r += m )
+         double *u = d + 2 * r, *v = d + 2 * ( r + mh );
+         for( j = 0; j < 2 * mh; j += 2 )      // u=data[i]; v=data[j]*w; data[i]=u+v;data[j]=u-v;
             {
-            std::complex<double> tempc;
-            i = r + j;
-            tempc = w * data[ i + mh ];              // u=data[i]; v=data[j]*w; data[i]=u+v;data[j]=u-v;
-            data[ i + mh ] = data[ i ] - tempc;
-            data[ i ] += tempc;
+            const double wr = w[ j ], wi = s * w[ j + 1 ];
+            const double tr = wr * v[ j ] - wi * v[ j + 1 ];
+            const double ti = wr * v[ j + 1 ] + wi * v[ j ];
+            v[ j ] = u[ j ] - tr;
+            v[ j + 1 ] = u[ j + 1 ] - ti;
+            u[ j ] += tr;
+            u[ j + 1 ] += ti;
             }
-      
-         w =  w * wp + w;  // w = w(1+wp) ==> w *=1+wp;
          }
       }
    }
@@ -327,39 +370,34 @@ static void _int_fourier( std::complex<double> data[], const size_t n, const int
 void _int_real_fourier( double data[], const size_t n, const int isign )
    {
    size_t i;
-   double theta, c1 = 0.5, c2;
-   std::complex<double> w, wp, h1, h2;
+   double c1 = 0.5, c2;
+   std::complex<double> h1, h2;
+   const std::complex<double> *twiddles = _int_fourier_twiddles( n ) + ( n >> 1 );  // exp( 2*PI*i*j/n )
 
-   theta = 3.14159265358979323846264 / (double)( n >> 1 );
    if( isign == 1 )
       {
       c2 = -c1;
       _int_fourier( (std::complex<double> *)data, n >> 1, 1 );
       }
    else
-      {
       c2 = c1;
-      theta = -theta;
-      }
-   wp = std::complex<double>( -2.0 * sin( 0.5 * theta ) * sin( 0.5 * theta ), sin( theta ) );
-   w = std::complex<double> ( 1 + wp.real(), wp.imag() );
    for( i = 1; i < (n>>2); i++ )
       {
       size_t i1, i2, i3, i4;
-      std::complex<double> tc;
+      std::complex<double> tc, w;
 
+      w = isign == 1 ? twiddles[ i ] : std::conj( twiddles[ i ] );
       i1 = i + i;
       i2 = i1 + 1;
       i3 = n + 1 - i2;
       i4 = i3 + 1;
       h1 = std::complex<double> ( c1 * ( data[i1] + data[i3] ), c1 * ( data[i2]-data[i4]));
       h2 = std::complex<double> ( -c2 * ( data[i2]+data[i4] ), c2 * ( data[i1]-data[i3]));
-      tc = w * h2;
+      tc = std::complex<double>( w.real() * h2.real() - w.imag() * h2.imag(), w.real() * h2.imag() + w.imag() * h2.real() );
       data[i1]=h1.real()+tc.real();
       data[i2]=h1.imag()+tc.imag();
       data[i3]=h1.real() - tc.real();
       data[i4]=-h1.imag() + tc.imag();
-      w *= ( std::complex<double>(1) + wp );
       }
    if( isign == 1 )
       {
@@ -376,6 +414,145 @@ void _int_real_fourier( double data[], const size_t n, const int isign )
       }
    }
 
+// The primes of the number theoretic transform, both k*2^m+1 with the primitive root 3
+static const uint64_t _int_ntt_primes[ 2 ] = { 998244353, 469762049 };
+
+// b^e mod p
+static uint64_t _int_ntt_pow( uint64_t b, uint64_t e, const uint64_t p )
+   {
+   uint64_t r = 1;
+   for( b %= p; e > 0; e >>= 1, b = b * b % p )
+      if( e & 1 )
+         r = r * b % p;
+   return r;
+   }
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	_int_ntt the number theoretic transform
+///	@return 	static void	-	
+///	@param   "data[]"	-	residues modulo the prime
+///	@param   "n"	-	number of element in data (must be a power of 2)
+///	@param   "prime"	-	index of the prime in _int_ntt_primes
+///	@param   "isign"	-	transform in(1) or out(-1)
+///
+///	@todo
+///
+/// Description:
+///   As _int_fourier() but in the integers modulo a prime, so the convolution is exact.
+///   The roots of unity are tabulated per thread the same way as _int_fourier_twiddles().
+///   The residues are below 2^30 so that a product fits in 64 bits.
+///   n must be a power of 2 and at most NTT_MAX_SIZE
+//
+static void _int_ntt( uint64_t data[], const size_t n, const int prime, const int isign )
+   {
+   static thread_local std::vector<uint64_t> roots[ 2 ][ 2 ];  // [prime][forward, inverse]
+   const uint64_t p = _int_ntt_primes[ prime ];
+   std::vector<uint64_t>& w = roots[ prime ][ isign == 1 ? 0 : 1 ];
+   size_t mh, m, r, j;
+
+   if( w.size() < n )
+      {
+      m = w.empty() ? 2 : 2 * w.size();
+      w.resize( n );
+      for( ; m <= n; m <<= 1 )
+         {
+         const uint64_t wm = _int_ntt_pow( isign == 1 ? 3 : _int_ntt_pow( 3, p - 2, p ), ( p - 1 ) / m, p );
+         w[ m / 2 ] = 1;
+         for( j = 1; j < m / 2; ++j )
+            w[ m / 2 + j ] = w[ m / 2 + j - 1 ] * wm % p;
+         }
+      }
+
+   _int_reverse_binary( data, n );
+
+   for( m = 2; n >= m; m <<= 1 )
+      {
+      const uint64_t *wm = w.data() + ( m >> 1 );
+      mh = m >> 1;
+
+      for( r = 0; r < n; r += m )
+         {
+         uint64_t *u = data + r, *v = data + r + mh;
+         for( j = 0; j < mh; ++j )
+            {
+            const uint64_t t = v[ j ] * wm[ j ] % p;
+            v[ j ] = u[ j ] >= t ? u[ j ] - t : u[ j ] + p - t;
+            u[ j ] = u[ j ] + t >= p ? u[ j ] + t - p : u[ j ] + t;
+            }
+         }
+      }
+
+   if( isign != 1 )
+      {
+      const uint64_t inv_n = _int_ntt_pow( n, p - 2, p );
+      for( j = 0; j < n; ++j )
+         data[ j ] = data[ j ] * inv_n % p;
+      }
+   }
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	_int_ntt_umul multiply two digit strings with the number theoretic transform
+///	@return 	std::string	-	the product with l1+l2 digits, a leading zero if there is no carry
+///	@param   "src1"	-	First unsigned source argument
+///	@param   "src2"	-	Second unsigned source argument, src1 squares it with a single forward transform
+///	@param   "radix"	-	radix of the digits, RADIX or F_RADIX
+///
+///	@todo
+///
+/// Description:
+///   The convolution is done modulo both primes and combined with the chinese remainder theorem.
+///   It is exact as long as l*(radix-1)^2 is below the product of the primes (about 4.7E17), unlike
+///   the double precision FFT whose rounding errors grow with the operand size. Serve both
+///   int_precision and float_precision, the digits are coded the same way for a given radix.
+//
+std::string _int_ntt_umul( const std::string *src1, const std::string *src2, const unsigned int radix )
+   {
+   const uint64_t p0 = _int_ntt_primes[ 0 ], p1 = _int_ntt_primes[ 1 ];
+   const uint64_t inv_p0 = _int_ntt_pow( p0, p1 - 2, p1 );  // p0^-1 mod p1
+   const bool square = src1 == src2;
+   const size_t l1 = src1->length(), l2 = src2->length();
+   static thread_local std::vector<uint64_t> a[ 2 ], b[ 2 ];
+   std::string des1;
+   size_t n, j;
+   uint64_t cy;
+
+   for( n = 1; n < l1 + l2 - 1; n <<= 1 ) ;
+   for( int k = 0; k < 2; ++k )
+      {
+      a[ k ].assign( n, 0 );
+      for( j = 0; j < l1; ++j )
+         a[ k ][ j ] = radix <= 10 ? (unsigned char)( (*src1)[ j ] - '0' ) : (unsigned char)(*src1)[ j ];
+      _int_ntt( a[ k ].data(), n, k, 1 );
+      if( square )
+         for( j = 0; j < n; ++j )
+            a[ k ][ j ] = a[ k ][ j ] * a[ k ][ j ] % _int_ntt_primes[ k ];
+      else
+         {
+         b[ k ].assign( n, 0 );
+         for( j = 0; j < l2; ++j )
+            b[ k ][ j ] = radix <= 10 ? (unsigned char)( (*src2)[ j ] - '0' ) : (unsigned char)(*src2)[ j ];
+         _int_ntt( b[ k ].data(), n, k, 1 );
+         for( j = 0; j < n; ++j )
+            a[ k ][ j ] = a[ k ][ j ] * b[ k ][ j ] % _int_ntt_primes[ k ];
+         }
+      _int_ntt( a[ k ].data(), n, k, -1 );
+      }
+
+   des1.resize( l1 + l2 );
+   for( cy = 0, j = l1 + l2 - 1; j-- > 0; )  // Chinese remainder and carry, least significant digit first
+      {
+      const uint64_t x0 = a[ 0 ][ j ], x1 = a[ 1 ][ j ];
+      const uint64_t t = x0 + p0 * ( ( x1 + p1 - x0 % p1 ) % p1 * inv_p0 % p1 ) + cy;
+      cy = t / radix;
+      des1[ j + 1 ] = (char)( radix <= 10 ? t - cy * radix + '0' : t - cy * radix );
+      }
+   des1[ 0 ] = (char)( radix <= 10 ? cy + '0' : cy );
+
+   return des1;
+   }
+
 
 ///	@author Henrik Vestermark (hve@hvks.com)
 ///	@date  1/19/2005
@@ -882,6 +1059,52 @@ string _int_precision_karatsuba_umul(const std::string *lhs, const std::string *
 	return result;
 	}
 
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	std::string _int_precision_karatsuba_usqr
+///	@return 	std::string	-	the result of squaring src
+///	@param   "src"	-	Unsigned source argument
+///
+///	@todo
+///
+/// Description:
+///   Square an unsigned decimal string, using the karatsuba method
+///   As _int_precision_karatsuba_umul() but the three partial products are all squares:
+///   (x0*B+x1)^2 = x0^2*B^2 + ((x0+x1)^2 - x0^2 - x1^2)*B + x1^2
+///   Notice when the square fits into a 64bit integer we switch to native multiplications.
+//
+string _int_precision_karatsuba_usqr(const std::string *src)
+	{
+	std::string result, z0, z1, z2, z3;
+	std::string src0, src1;
+	std::string s01, z01;
+	int wrap;
+	size_t half_length, length = src->size();
+
+	if (( RADIX == BASE_10 && 2 * length <= 18 ) || ( RADIX == BASE_256 && 2 * length <= 8 ) || ( RADIX == BASE_8 && 2 * length <= 20 ) || ( RADIX == BASE_2 && 2 * length <= 64 ) )
+		return _int_precision_umul64((std::string *)src, (std::string *)src);
+
+	// Splitting
+	half_length = length >> 1;
+	src0 = src->substr(0, half_length); src1 = src->substr(half_length);
+
+	// Evaluation
+	z0 = _int_precision_karatsuba_usqr(&src0);
+	z1 = _int_precision_karatsuba_usqr(&src1);
+	s01 = _int_precision_uadd(&src0, &src1);
+	z2 = _int_precision_karatsuba_usqr(&s01);
+	z01 = _int_precision_uadd(&z0, &z1);
+	z3 = _int_precision_usub(&wrap, &z2, &z01);
+
+	// Recomposition
+	z0.append(2 * (length - half_length), ICHARACTER(0));
+	z3.append(length - half_length, ICHARACTER(0));
+	z01 = _int_precision_uadd(&z0, &z1);
+	result = _int_precision_uadd(&z01, &z3);
+	_int_precision_strip_leading_zeros(&result);
+	return result;
+	}
+
 ///	@author Henrik Vestermark (hve@hvks.com)
 ///	@date  22-Aug-2019
 ///	@brief 	std::string _int_precision_schonhage_strassen_linear_umul
@@ -955,15 +1178,24 @@ std::string _int_precision_umul_fourier( std::string *src1, std::string *src2 )
    std::string::iterator pos;
    size_t n, l, l1, l2, j;
    double *a, *b, cy;
+   static thread_local std::vector<double> va, vb;  // Keep the capacity between calls
    
    l1 = src1->length();
    l2 = src2->length();
-   des1.reserve(l1 + l2 + 16);  // Ensure enough space to hold the Multiplication result to avoid reallocation of des1
    l = l1 < l2 ? l2 : l1;
+   if( l >= NTT_THRESHOLD && l1 + l2 <= NTT_MAX_SIZE )  // Exact transform for large operands
+      {
+      des1 = _int_ntt_umul( src1, src2, RADIX );
+      _int_precision_strip_leading_zeros( &des1 );
+      return des1;
+      }
+   des1.reserve(l1 + l2 + 16);  // Ensure enough space to hold the Multiplication result to avoid reallocation of des1
    for( n = 1; n < l; n <<= 1 ) ;
    n <<= 1;
-   a = new double[n];
-   b = new double[n];
+   va.resize( n );
+   vb.resize( n );
+   a = va.data();
+   b = vb.data();
 
    // Even that the 4 for loop can been parallelized it is not worth it due to openMP overhead
    for( l=0, pos = src1->begin(); pos != src1->end(); ++pos ) 
@@ -1024,7 +1256,74 @@ std::string _int_precision_umul_fourier( std::string *src1, std::string *src2 )
    
    _int_precision_strip_leading_zeros( &des1 );
 
-   delete [] a, b;
+   return des1;
+   }
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	std::string _int_precision_usqr_fourier
+///	@return 	std::string	-	the result of squaring src1
+///	@param   "src1"	-	Unsigned source argument
+///
+///	@todo
+///
+/// Description:
+///   Square an unsigned decimal string
+///   As _int_precision_umul_fourier() but the transform of the source is squared pointwise,
+///   so only one forward transform and half of the memory is needed
+//
+std::string _int_precision_usqr_fourier( std::string *src1 )
+   {
+   unsigned short ireg = 0;
+   std::string des1;
+   std::string::iterator pos;
+   size_t n, l, l1, j;
+   double *a, cy;
+   static thread_local std::vector<double> va;  // Keep the capacity between calls
+   
+   l1 = src1->length();
+   if( l1 >= NTT_THRESHOLD && 2 * l1 <= NTT_MAX_SIZE )  // Exact transform for large operands
+      {
+      des1 = _int_ntt_umul( src1, src1, RADIX );
+      _int_precision_strip_leading_zeros( &des1 );
+      return des1;
+      }
+   des1.reserve(2 * l1 + 16);
+   for( n = 1; n < l1; n <<= 1 ) ;
+   n <<= 1;
+   va.resize( n );
+   a = va.data();
+
+   for( l=0, pos = src1->begin(); pos != src1->end(); ++pos ) 
+	   a[l++] = (double)IDIGIT(*pos);
+   for( ; l < n; ) 
+	   a[l++] = (double)0;
+   _int_real_fourier(a, n, 1);
+
+   a[0] *= a[0];
+   a[1] *= a[1];
+   for( j = 2; j < n; j += 2 )
+      {
+      double t;
+      a[j]=(t=a[j])*t-a[j+1]*a[j+1];
+      a[j+1]=2*t*a[j+1];
+      }
+   _int_real_fourier( a, n, -1 );
+   for( cy=0, j=0; j <= n-1; ++j )
+      {
+      double t;
+      t=a[n-1-j]/(n>>1)+cy+0.5;
+      cy=(unsigned long)( t/RADIX );
+      a[n-1-j]=t-cy*RADIX;
+      }
+
+   ireg = (unsigned short)cy;
+   if( ireg != 0 )
+      des1.append( 1, ICHARACTER( (char)ireg ) );
+   for( j = 0; j < (int)(2 * l1 -1); j++ )
+      des1.append( 1, ICHARACTER( (char)a[ j ] ) );
+   
+   _int_precision_strip_leading_zeros( &des1 );
 
    return des1;
    }
@@ -2203,7 +2502,7 @@ int_precision lcm(const int_precision& a, const int_precision& b)
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-class float_precision_ctrl float_precision_ctrl(PRECISION,ROUND_NEAR);
+thread_local class float_precision_ctrl float_precision_ctrl(PRECISION,ROUND_NEAR);
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -3201,7 +3500,18 @@ int _float_precision_rounding( std::string *m, int sign, size_t precision, enum
          size_t before;
 
          before = m->length();
-         *m = _float_precision_uadd_short( m, 1 );
+         std::string::reverse_iterator pos;
+         for( pos = m->rbegin(); pos != m->rend(); ++pos )  // Add one in place
+            {
+            if( FDIGIT( *pos ) + 1 < F_RADIX )
+               {
+               *pos = FCHARACTER( FDIGIT( *pos ) + 1 );
+               break;
+               }
+            *pos = FCHARACTER( 0 );
+            }
+         if( pos == m->rend() )
+            m->insert( m->begin(), (char)FCHARACTER( 1 ) );
          if( m->length() > before )
             {
             if( m->length() > precision )
@@ -3267,7 +3577,7 @@ std::string _float_precision_uadd_short( std::string *src1, unsigned int d )
    {
    unsigned short ireg;
    std::string::reverse_iterator r1_pos, rd_pos;
-   std::string des1;
+   std::string des1 = _float_precision_buffer();
 
    des1.reserve( src1->capacity() );
    des1 = *src1;
@@ -3313,7 +3623,7 @@ std::string _float_precision_uadd_short( std::string *src1, unsigned int d )
 std::string _float_precision_uadd( std::string *src1, std::string *src2 )
    {
    unsigned short ireg = 0;
-   std::string des1;
+   std::string des1 = _float_precision_buffer();
    std::string::reverse_iterator r_pos, r_end, rd_pos;
 
    if( src1->length() >= src2->length() )
@@ -3372,7 +3682,7 @@ std::string _float_precision_usub_short( int *result, std::string *src1, unsigne
    {
    unsigned short ireg = RADIX;
    std::string::reverse_iterator r1_pos;
-   std::string des1;
+   std::string des1 = _float_precision_buffer();
 
    if( d > F_RADIX )
       { throw float_precision::out_of_range(); }
@@ -3418,7 +3728,7 @@ std::string _float_precision_usub( int *result, std::string *src1, std::string *
    {
    unsigned short ireg = F_RADIX;
    std::string::reverse_iterator r1_pos, r2_pos;
-   std::string des1;
+   std::string des1 = _float_precision_buffer();
 
    r1_pos = src1->rbegin();
    r2_pos = src2->rbegin();
@@ -3460,7 +3770,7 @@ std::string _float_precision_umul_short( std::string *src1, unsigned int d )
    {
    unsigned short ireg = 0;
    std::string::reverse_iterator r1_pos;
-   std::string des1;
+   std::string des1 = _float_precision_buffer();
 
    des1.reserve( src1->capacity() );
    if( d > F_RADIX )
@@ -3560,15 +3870,24 @@ std::string _float_precision_umul_fourier( std::string *src1, std::string *src2
    std::string::iterator pos;
    size_t n, j, l, l1, l2;
    double *a, *b, cy;
+   static thread_local std::vector<double> va, vb;  // Keep the capacity between calls
    
    l1 = src1->length();
    l2 = src2->length();
-   des1.reserve(l1 + l2 + 16);
    l = l1 < l2 ? l2 : l1;
+   if( l >= NTT_THRESHOLD && l1 + l2 <= NTT_MAX_SIZE )  // Exact transform for large operands
+      {
+      des1 = _int_ntt_umul( src1, src2, F_RADIX );
+      _float_precision_strip_leading_zeros( &des1 );
+      return des1;
+      }
+   des1.reserve(l1 + l2 + 16);
    for( n = 1; n < l; n <<= 1 ) ;
    n <<= 1;
-   a = new double [n];
-   b = new double[n]; 
+   va.resize( n );
+   vb.resize( n );
+   a = va.data();
+   b = vb.data();
  
    for (l = 0, pos = src1->begin(); pos != src1->end(); ++l, ++pos )
 	   a[l] = (double)FDIGIT(*pos);
@@ -3618,11 +3937,584 @@ std::string _float_precision_umul_fourier( std::string *src1, std::string *src2
       des1.append( 1, FCHARACTER( (char)b[ j ] ) );
    
    _float_precision_strip_leading_zeros( &des1 );
-   delete [] a, b;
 
    return des1;
    }
 
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	square a floating point string using a fourier transformation
+///	@return 	std::string - Return the squared string
+///	@param   "src1"	-	The source string
+///
+///	@todo  
+///
+/// Description:
+///   Square an unsigned decimal string
+///   As _float_precision_umul_fourier() but the transform of the source is squared pointwise,
+///   so only one forward transform and half of the memory is needed
+//
+std::string _float_precision_usqr_fourier( std::string *src1 )
+   {
+   unsigned short ireg = 0;
+   std::string des1;
+   std::string::iterator pos;
+   size_t n, j, l, l1;
+   double *a, cy;
+   static thread_local std::vector<double> va;  // Keep the capacity between calls
+   
+   l1 = src1->length();
+   if( l1 >= NTT_THRESHOLD && 2 * l1 <= NTT_MAX_SIZE )  // Exact transform for large operands
+      {
+      des1 = _int_ntt_umul( src1, src1, F_RADIX );
+      _float_precision_strip_leading_zeros( &des1 );
+      return des1;
+      }
+   des1.reserve(2 * l1 + 16);
+   for( n = 1; n < l1; n <<= 1 ) ;
+   n <<= 1;
+   va.resize( n );
+   a = va.data();
+ 
+   for (l = 0, pos = src1->begin(); pos != src1->end(); ++l, ++pos )
+	   a[l] = (double)FDIGIT(*pos);
+   for (; l < n; ++l) a[l] = (double)0;
+   _int_real_fourier(a, n, 1);
+
+   a[0] *= a[0];
+   a[1] *= a[1];
+   for( j = 2; j < n; j += 2 )
+      {
+      double t;
+      a[j]=(t=a[j])*t-a[j+1]*a[j+1];
+      a[j+1]=2*t*a[j+1];
+      }
+   _int_real_fourier( a, n, -1 );
+   for( cy=0, j=0; j <= n-1; ++j )
+      {
+      double t;
+      t=a[n-1-j]/(n>>1)+cy+0.5;
+      cy=(unsigned long)( t/ F_RADIX );
+      a[n-1-j]=t-cy*F_RADIX;
+      }
+
+   ireg = (unsigned short)cy;
+   if( ireg != 0 )
+      des1.append( 1, FCHARACTER( (char)ireg ) );
+   for( j = 0; j < (int)(2 * l1 -1); j++ )
+      des1.append( 1, FCHARACTER( (char)a[ j ] ) );
+   
+   _float_precision_strip_leading_zeros( &des1 );
+
+   return des1;
+   }
+
+#if defined(APML_BUFFERS)
+// Recycled mantissa buffers of this thread. Static float_precision can be destroyed after them
+static thread_local bool _float_precision_buffers_released = false;
+static thread_local struct _float_precision_buffer_pool
+	{
+	std::vector<std::string> buffers;
+	~_float_precision_buffer_pool() { _float_precision_buffers_released = true; }
+	} _float_precision_buffers;
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	Get an empty mantissa buffer
+///	@return 	std::string - empty string with a capacity of at least F_BUFFER_DIGITS
+///
+///	@todo  
+///
+/// Description:
+///   Take a recycled buffer of the thread, allocate a new one only if there is none
+//
+std::string _float_precision_buffer()
+	{
+	std::string des1;
+
+	if( _float_precision_buffers_released || _float_precision_buffers.buffers.empty() )
+		des1.reserve( F_BUFFER_DIGITS );
+	else
+		{
+		des1.swap( _float_precision_buffers.buffers.back() );
+		_float_precision_buffers.buffers.pop_back();
+		des1.clear();
+		}
+	return des1;
+	}
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	Give a mantissa buffer back
+///	@return 	nothing
+///	@param   "s"	-	string that is no longer needed
+///
+///	@todo  
+///
+/// Description:
+///   Keep the buffer of s for _float_precision_buffer() if it is of the recycled size
+///   and the thread does not keep too many already. s is left empty
+//
+void _float_precision_recycle( std::string *s )
+	{
+	const size_t max_buffers = 64;
+
+	if( _float_precision_buffers_released || s->capacity() < F_BUFFER_DIGITS || s->capacity() > 4 * F_BUFFER_DIGITS )
+		return;
+	std::vector<std::string>& buffers = _float_precision_buffers.buffers;
+	if( buffers.capacity() == 0 )
+		buffers.reserve( max_buffers );
+	if( buffers.size() < max_buffers )
+		{
+		buffers.emplace_back();
+		buffers.back().swap( *s );
+		}
+	}
+#endif
+
+// Radix digits packed into one binary limb, so that a product of two limbs fits in 64 bits with room for two more limbs
+static unsigned int _float_precision_limb_digits()
+	{
+	switch( F_RADIX )
+		{
+		case BASE_2: return 31;
+		case BASE_8: return 10;
+		case BASE_10: return 9;
+		case BASE_16: return 7;
+		default: return 3;  // BASE_256
+		}
+	}
+
+// The limb radix F_RADIX^k
+static uint64_t _float_precision_limb_radix( unsigned int k )
+	{
+	uint64_t limb_radix = 1;
+	for( unsigned int i = 0; i < k; ++i )
+		limb_radix *= F_RADIX;
+	return limb_radix;
+	}
+
+// Pack the radix digits of src, most significant first, into limbs of k digits, least significant limb first
+static void _float_precision_pack_limbs( const std::string *src, unsigned int k, std::vector<uint64_t>& limbs )
+	{
+	const size_t len = src->length();
+	limbs.assign( ( len + k - 1 ) / k, 0 );
+	for( size_t i = 0; i < len; ++i )
+		{
+		uint64_t& limb = limbs[ ( len - 1 - i ) / k ];
+		limb = limb * F_RADIX + FDIGIT( (*src)[i] );
+		}
+	}
+
+// Unpack limbs of k digits back to radix digits, most significant first
+static void _float_precision_unpack_limbs( const std::vector<uint64_t>& limbs, unsigned int k, std::string *des )
+	{
+	des->reserve( limbs.size() * k );
+	for( auto limb : limbs )
+		for( unsigned int i = 0; i < k; ++i, limb /= F_RADIX )
+			des->push_back( FCHARACTER( (char)( limb % F_RADIX ) ) );
+	reverse( des->begin(), des->end() );
+	}
+
+// Crossovers of the multiplication, measured by _float_precision_tune_umul()
+float_precision_umul_thresholds _float_precision_umul_thresholds = { F_TOOM3_THRESHOLD, F_LIMBS_THRESHOLD };
+
+// Schoolbook product of the limbs a[0..na) and b[0..nb), least significant first. r[0..na+nb) is overwritten
+static void _float_precision_limbs_mul_basecase( const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *r, const uint64_t limb_radix )
+	{
+	std::fill( r, r + na + nb, 0 );
+	for( size_t i = 0; i < na; ++i )
+		{
+		uint64_t carry = 0;
+		if( a[i] == 0 )
+			continue;
+		for( size_t j = 0; j < nb; ++j )
+			{
+			const uint64_t t = a[i] * b[j] + r[i + j] + carry;
+			carry = t / limb_radix;
+			r[i + j] = t - carry * limb_radix;
+			}
+		r[i + nb] = carry;
+		}
+	}
+
+// Schoolbook square of the limbs a[0..n). The product a[i]*a[j] equals a[j]*a[i], so each cross product
+// is calculated once and doubled and only the squares on the diagonal are added. r[0..2n) is overwritten
+static void _float_precision_limbs_sqr_basecase( const uint64_t *a, size_t n, uint64_t *r, const uint64_t limb_radix )
+	{
+	uint64_t carry;
+
+	std::fill( r, r + 2 * n, 0 );
+	for( size_t i = 0; i < n; ++i )  // Cross products i < j
+		{
+		carry = 0;
+		if( a[i] == 0 )
+			continue;
+		for( size_t j = i + 1; j < n; ++j )
+			{
+			const uint64_t t = a[i] * a[j] + r[i + j] + carry;
+			carry = t / limb_radix;
+			r[i + j] = t - carry * limb_radix;
+			}
+		r[i + n] = carry;
+		}
+	carry = 0;
+	for( size_t i = 0; i < 2 * n; ++i )  // Double them
+		{
+		const uint64_t t = 2 * r[i] + carry;
+		carry = t / limb_radix;
+		r[i] = t - carry * limb_radix;
+		}
+	carry = 0;
+	for( size_t i = 0; i < n; ++i )  // Add the squares on the diagonal
+		{
+		uint64_t t = a[i] * a[i] + r[2 * i] + carry;
+		carry = t / limb_radix;
+		r[2 * i] = t - carry * limb_radix;
+		t = r[2 * i + 1] + carry;
+		carry = t / limb_radix;
+		r[2 * i + 1] = t - carry * limb_radix;
+		}
+	}
+
+// Remove the most significant zero limbs
+static void _float_precision_limbs_trim( std::vector<uint64_t>& a )
+	{
+	while( !a.empty() && a.back() == 0 )
+		a.pop_back();
+	}
+
+// a += b * m * limb_radix^shift, m is small
+static void _float_precision_limbs_addmul( std::vector<uint64_t>& a, const std::vector<uint64_t>& b, uint64_t m, size_t shift, const uint64_t limb_radix )
+	{
+	uint64_t carry = 0;
+	size_t i;
+
+	if( a.size() < b.size() + shift + 1 )
+		a.resize( b.size() + shift + 1, 0 );
+	for( i = 0; i < b.size(); ++i )
+		{
+		const uint64_t t = a[i + shift] + b[i] * m + carry;
+		carry = t / limb_radix;
+		a[i + shift] = t - carry * limb_radix;
+		}
+	for( i += shift; carry != 0; ++i )
+		{
+		if( i == a.size() )
+			a.push_back( 0 );
+		const uint64_t t = a[i] + carry;
+		carry = t / limb_radix;
+		a[i] = t - carry * limb_radix;
+		}
+	_float_precision_limbs_trim( a );
+	}
+
+// a -= b * m, m is small and a is not less than b * m
+static void _float_precision_limbs_submul( std::vector<uint64_t>& a, const std::vector<uint64_t>& b, uint64_t m, const uint64_t limb_radix )
+	{
+	uint64_t borrow = 0;
+
+	for( size_t i = 0; i < a.size() && ( i < b.size() || borrow != 0 ); ++i )
+		{
+		uint64_t t = borrow + ( i < b.size() ? b[i] * m : 0 );
+		borrow = t / limb_radix;
+		t -= borrow * limb_radix;
+		if( a[i] < t )
+			{
+			a[i] += limb_radix - t;
+			++borrow;
+			}
+		else
+			a[i] -= t;
+		}
+	_float_precision_limbs_trim( a );
+	}
+
+// a /= d, the division is exact
+static void _float_precision_limbs_divexact( std::vector<uint64_t>& a, uint64_t d, const uint64_t limb_radix )
+	{
+	uint64_t rem = 0;
+
+	for( size_t i = a.size(); i-- > 0; )
+		{
+		const uint64_t t = rem * limb_radix + a[i];
+		a[i] = t / d;
+		rem = t - a[i] * d;
+		}
+	_float_precision_limbs_trim( a );
+	}
+
+static std::vector<uint64_t> _float_precision_limbs_toom3( const std::vector<uint64_t>&, const std::vector<uint64_t>&, const size_t, const uint64_t );
+
+// Product of the limbs a and b, the square if they are the same object. Toom-3 from toom3_limbs limbs
+static std::vector<uint64_t> _float_precision_limbs_mul( const std::vector<uint64_t>& a, const std::vector<uint64_t>& b, const size_t toom3_limbs, const uint64_t limb_radix )
+	{
+	const size_t na = a.size(), nb = b.size();
+	std::vector<uint64_t> r;
+
+	if( na == 0 || nb == 0 )
+		return r;
+	if( std::min( na, nb ) >= toom3_limbs && std::max( na, nb ) <= 2 * std::min( na, nb ) )
+		return _float_precision_limbs_toom3( a, b, toom3_limbs, limb_radix );
+	r.resize( na + nb );
+	if( &a == &b )
+		_float_precision_limbs_sqr_basecase( a.data(), na, r.data(), limb_radix );
+	else
+		_float_precision_limbs_mul_basecase( a.data(), na, b.data(), nb, r.data(), limb_radix );
+	_float_precision_limbs_trim( r );
+	return r;
+	}
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	multiply limbs with the Toom-Cook 3-way method
+///	@return 	std::vector<uint64_t> - The product, least significant limb first
+///	@param   "a"	-	The first limbs, least significant first
+///   @param   "b"  - The second limbs, the square of a if it is the same object
+///   @param   "toom3_limbs"  - operand limbs from which the parts are multiplied with Toom-3 too
+///   @param   "limb_radix"  - the radix of a limb
+///
+///	@todo  
+///
+/// Description:
+///   The operands are split in three parts of k limbs, a = a2*X^2 + a1*X + a0 with X = limb_radix^k.
+///   The product polynomial c4*X^4 + ... + c0 is evaluated at 0, 1, 2, 3 and infinity with five products
+///   of k limbs instead of the nine of the schoolbook method. These points keep every evaluation and
+///   every step of the interpolation non negative, so only unsigned limbs and exact divisions by 2 and 3
+///   are needed:
+///   s1 = r1 - c0 - c4 = c1 + c2 + c3, s2 = ( r2 - c0 - 16*c4 ) / 2 = c1 + 2*c2 + 4*c3,
+///   s3 = ( r3 - c0 - 81*c4 ) / 3 = c1 + 3*c2 + 9*c3, t1 = s2 - s1 = c2 + 3*c3, t2 = s3 - s2 = c2 + 5*c3
+//
+static std::vector<uint64_t> _float_precision_limbs_toom3( const std::vector<uint64_t>& a, const std::vector<uint64_t>& b, const size_t toom3_limbs, const uint64_t limb_radix )
+	{
+	const bool square = &a == &b;
+	const size_t k = ( std::max( a.size(), b.size() ) + 2 ) / 3;
+	std::vector<uint64_t> a0, a1, a2, b0, b1, b2, ea[3], eb[3], r0, r[3], r4, c1, c2, c3, res;
+
+	const auto split = [k]( const std::vector<uint64_t>& v, std::vector<uint64_t>& v0, std::vector<uint64_t>& v1, std::vector<uint64_t>& v2 )
+		{
+		const auto part = [&v, k]( size_t i, std::vector<uint64_t>& p )
+			{
+			p.assign( v.begin() + std::min( i * k, v.size() ), v.begin() + std::min( i * k + k, v.size() ) );
+			_float_precision_limbs_trim( p );
+			};
+		part( 0, v0 ); part( 1, v1 ); part( 2, v2 );
+		};
+	const auto evaluate = [limb_radix]( const std::vector<uint64_t>& v0, const std::vector<uint64_t>& v1, const std::vector<uint64_t>& v2, std::vector<uint64_t> e[3] )
+		{
+		for( uint64_t x = 1; x <= 3; ++x )  // v0 + x*v1 + x^2*v2
+			{
+			e[x - 1] = v0;
+			_float_precision_limbs_addmul( e[x - 1], v1, x, 0, limb_radix );
+			_float_precision_limbs_addmul( e[x - 1], v2, x * x, 0, limb_radix );
+			}
+		};
+
+	split( a, a0, a1, a2 );
+	evaluate( a0, a1, a2, ea );
+	if( !square )
+		{
+		split( b, b0, b1, b2 );
+		evaluate( b0, b1, b2, eb );
+		}
+	r0 = _float_precision_limbs_mul( a0, square ? a0 : b0, toom3_limbs, limb_radix );
+	r4 = _float_precision_limbs_mul( a2, square ? a2 : b2, toom3_limbs, limb_radix );
+	for( int x = 0; x < 3; ++x )
+		r[x] = _float_precision_limbs_mul( ea[x], square ? ea[x] : eb[x], toom3_limbs, limb_radix );
+
+	// Interpolation
+	std::vector<uint64_t>& s1 = r[0], &s2 = r[1], &s3 = r[2];
+	_float_precision_limbs_submul( s1, r0, 1, limb_radix );
+	_float_precision_limbs_submul( s1, r4, 1, limb_radix );
+	_float_precision_limbs_submul( s2, r0, 1, limb_radix );
+	_float_precision_limbs_submul( s2, r4, 16, limb_radix );
+	_float_precision_limbs_divexact( s2, 2, limb_radix );
+	_float_precision_limbs_submul( s3, r0, 1, limb_radix );
+	_float_precision_limbs_submul( s3, r4, 81, limb_radix );
+	_float_precision_limbs_divexact( s3, 3, limb_radix );
+	c3 = s3;
+	_float_precision_limbs_submul( c3, s2, 1, limb_radix );  // t2
+	c2 = s2;
+	_float_precision_limbs_submul( c2, s1, 1, limb_radix );  // t1
+	_float_precision_limbs_submul( c3, c2, 1, limb_radix );
+	_float_precision_limbs_divexact( c3, 2, limb_radix );
+	_float_precision_limbs_submul( c2, c3, 3, limb_radix );
+	c1 = s1;
+	_float_precision_limbs_submul( c1, c2, 1, limb_radix );
+	_float_precision_limbs_submul( c1, c3, 1, limb_radix );
+
+	// Recomposition
+	res.reserve( a.size() + b.size() + 1 );
+	res = r0;
+	_float_precision_limbs_addmul( res, c1, 1, k, limb_radix );
+	_float_precision_limbs_addmul( res, c2, 1, 2 * k, limb_radix );
+	_float_precision_limbs_addmul( res, c3, 1, 3 * k, limb_radix );
+	_float_precision_limbs_addmul( res, r4, 1, 4 * k, limb_radix );
+	return res;
+	}
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	multiply two floating point strings packed into binary limbs
+///	@return 	std::string - Return the multiplied string
+///	@param   "src1"	-	The first source string
+///   @param   "src2"  - The second source string
+///
+///	@todo  
+///
+/// Description:
+///   Multiply two unsigned decimal strings
+///   The digits are packed into 64 bit limbs holding several radix digits each (10^9 for BASE_10)
+///   and multiplied with the schoolbook method, that beats the FFT for the precisions
+///   a Mandelbrot iteration uses. From _float_precision_umul_thresholds.toom3 digits the limbs
+///   are multiplied with Toom-3. The storage and the result remain radix digits.
+//
+std::string _float_precision_umul_limbs( std::string *src1, std::string *src2 )
+	{
+	const unsigned int k = _float_precision_limb_digits();
+	const uint64_t limb_radix = _float_precision_limb_radix( k );
+	const size_t toom3_limbs = std::max<size_t>( 3, _float_precision_umul_thresholds.toom3 / k );
+	static thread_local std::vector<uint64_t> a, b, r;  // Keep the capacity between calls
+	std::string des1 = _float_precision_buffer();
+
+	_float_precision_pack_limbs( src1, k, a );
+	_float_precision_pack_limbs( src2, k, b );
+	if( std::min( a.size(), b.size() ) >= toom3_limbs )
+		{
+		_float_precision_limbs_trim( a );
+		_float_precision_limbs_trim( b );
+		_float_precision_unpack_limbs( _float_precision_limbs_mul( a, b, toom3_limbs, limb_radix ), k, &des1 );
+		}
+	else
+		{
+		r.resize( a.size() + b.size() );
+		_float_precision_limbs_mul_basecase( a.data(), a.size(), b.data(), b.size(), r.data(), limb_radix );
+		_float_precision_unpack_limbs( r, k, &des1 );
+		}
+	_float_precision_strip_leading_zeros( &des1 );
+
+	return des1;
+	}
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	square a floating point string packed into binary limbs
+///	@return 	std::string - Return the squared string
+///	@param   "src1"	-	The source string
+///
+///	@todo  
+///
+/// Description:
+///   Square an unsigned decimal string with the limbs of _float_precision_umul_limbs().
+///   Each cross product is calculated once and doubled, about half of the limb multiplications,
+///   and Toom-3 squares its parts from _float_precision_umul_thresholds.toom3 digits.
+//
+std::string _float_precision_usqr_limbs( std::string *src1 )
+	{
+	const unsigned int k = _float_precision_limb_digits();
+	const uint64_t limb_radix = _float_precision_limb_radix( k );
+	const size_t toom3_limbs = std::max<size_t>( 3, _float_precision_umul_thresholds.toom3 / k );
+	static thread_local std::vector<uint64_t> a, r;  // Keep the capacity between calls
+	std::string des1 = _float_precision_buffer();
+
+	_float_precision_pack_limbs( src1, k, a );
+	if( a.size() >= toom3_limbs )
+		{
+		_float_precision_limbs_trim( a );
+		_float_precision_unpack_limbs( _float_precision_limbs_mul( a, a, toom3_limbs, limb_radix ), k, &des1 );
+		}
+	else
+		{
+		r.resize( 2 * a.size() );
+		_float_precision_limbs_sqr_basecase( a.data(), a.size(), r.data(), limb_radix );
+		_float_precision_unpack_limbs( r, k, &des1 );
+		}
+	_float_precision_strip_leading_zeros( &des1 );
+
+	return des1;
+	}
+
+///	@author Mandelbrot-Gempyre
+///	@date  18/Oct/2026
+///	@brief 	measure the crossovers of the multiplication on this CPU
+///	@return 	float_precision_umul_thresholds - The measured crossovers, that are also taken in use
+///
+///	@todo  
+///
+/// Description:
+///   Time the schoolbook limbs against Toom-3, and then the limbs against the FFT, for operands of
+///   growing length. A crossover is the first length where the other method is faster twice in a row,
+///   if there is none up to the longest length measured the method is not used.
+///   Takes about a tenth of a second. Call it before starting threads that multiply, the thresholds
+///   are shared by all of them.
+//
+float_precision_umul_thresholds _float_precision_tune_umul()
+	{
+	const size_t never = ~(size_t)0;
+	uint64_t seed = 1;
+	float_precision_umul_thresholds& thresholds = _float_precision_umul_thresholds;
+
+	const auto digits = [&seed]( size_t length )
+		{
+		std::string s;
+		for( size_t i = 0; i < length; ++i )
+			{
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			s.push_back( FCHARACTER( (char)( ( seed >> 33 ) % F_RADIX ) ) );
+			}
+		s[0] = FCHARACTER( 1 );
+		return s;
+		};
+	const auto seconds = []( const std::function<void()>& f )  // Per call, the best of three runs of half a millisecond
+		{
+		double best = 1e9;
+		for( int run = 0; run < 3; ++run )
+			{
+			const auto start = std::chrono::steady_clock::now();
+			std::chrono::duration<double> elapsed( 0 );
+			int calls = 0;
+			for( ; elapsed.count() < 5e-4; ++calls )
+				{
+				f();
+				elapsed = std::chrono::steady_clock::now() - start;
+				}
+			best = std::min( best, elapsed.count() / calls );
+			}
+		return best;
+		};
+	const auto crossover = [&]( size_t from, size_t to, const std::function<bool( size_t )>& faster )
+		{
+		int wins = 0;
+		size_t length, previous = from;
+		for( length = from; length <= to; previous = length, length += length / 5 )
+			if( !faster( length ) )
+				wins = 0;
+			else
+				if( ++wins == 2 )
+					return previous;
+		return never;
+		};
+
+	thresholds.toom3 = crossover( 60, 3000, [&]( size_t length )
+		{
+		std::string s1 = digits( length ), s2 = digits( length ), r;
+		thresholds.toom3 = never;
+		const double schoolbook = seconds( [&](){ r = _float_precision_umul_limbs( &s1, &s2 ); } );
+		thresholds.toom3 = length;  // One level of Toom-3 over the schoolbook
+		const double toom3 = seconds( [&](){ r = _float_precision_umul_limbs( &s1, &s2 ); } );
+		return toom3 < schoolbook;
+		} );
+	thresholds.fourier = crossover( 200, 20000, [&]( size_t length )
+		{
+		std::string s1 = digits( length ), s2 = digits( length ), r;
+		const double limbs = seconds( [&](){ r = _float_precision_umul_limbs( &s1, &s2 ); } );
+		const double fourier = seconds( [&](){ r = _float_precision_umul_fourier( &s1, &s2 ); } );
+		return fourier < limbs;
+		} );
+
+	return thresholds;
+	}
+
 ///	@author Henrik Vestermark (hve@hvks.com)
 ///	@date  1/21/2005
 ///	@brief 	divide a short integer into a floating point string (mantissa)
@@ -3852,13 +4744,15 @@ float_precision float_precision::epsilon()
 ///
 /// Description:
 ///   Inverse of V
-///   Using a Newton iterations Un = U(2-UV)
+///   Using a Newton iterations Un = U(2-UV) with iterative deepening as sqrt(), each step doubles
+///   the correct digits so the working precision is doubled too and only the last steps are done
+///   with the full precision. A division costs a few multiplications at the full precision.
 ///   Always return the result with 2 digits higher precision that argument
 ///   _float_precision_inverse() return a interim result for a basic operation like /
 //
 float_precision _float_precision_inverse( const float_precision& a )
    {
-   size_t precision;
+   size_t precision, digits;
    size_t i, imax;
    int expo;
    double fv, dv, fu;
@@ -3895,11 +4789,17 @@ float_precision _float_precision_inverse( const float_precision& a )
    u = float_precision( fu );
    
    // Now iterate using Netwon Un=U(2-UV)
-   for(;;)
+   for( digits = min( (size_t)32, precision + 3 ); ; digits = min( precision + 3, digits * 2 ) )
       {
-      r = u * v;                 // UV
+      // Increase precision by a factor of two for the working variables r & u
+      r.precision( digits );
+      u.precision( digits );
+      r = v;                     // V rounded to the precision of r
+      r *= u;                    // UV
       r = c2-r;                  // 2-UV
       u *= r;                    // Un=U(2-UV)
+      if( digits < precision + 3 )  // Final iteration steps are done with the full precision
+         continue;
       for( pos = r.ref_mantissa()->begin(), pos++, i = 0; pos != r.ref_mantissa()->end(); i++, pos++ )
          if( FDIGIT( *pos ) )
             break;
@@ -4336,10 +5236,11 @@ static std::string spigot_lnxy_64(const unsigned int x, const unsigned int y, co
 //
 float_precision _float_table( enum table_type tt, size_t precision )
    {
-   static float_precision ln2( 0, 0, ROUND_NEAR );
-   static float_precision ln10( 0, 0, ROUND_NEAR );
-   static float_precision pi( 0, 0, ROUND_NEAR );
-   static float_precision e( 0, 0, ROUND_NEAR);
+   // Per thread, so that threads do not extend a constant under each other
+   static thread_local float_precision ln2( 0, 0, ROUND_NEAR );
+   static thread_local float_precision ln10( 0, 0, ROUND_NEAR );
+   static thread_local float_precision pi( 0, 0, ROUND_NEAR );
+   static thread_local float_precision e( 0, 0, ROUND_NEAR);
    const float_precision c1(1);
    float_precision res(0, precision, ROUND_NEAR);
 
@@ -0,0 +1,403 @@
+
+#include "stripedrender.h"
+#include "imagewriter.h"
+#include "pngwriter.h"
+#include "iterationdata.h"
+#include "tilepyramid.h"
+#include "expmap.h"
+#include "zoomsequence.h"
+
+#include <iostream>
+#include <fstream>
+#include <unordered_map>
+#include <optional>
+#include <memory>
+#include <functional>
+#include <filesystem>
+
+#if defined(USE_ZLIB)
+static constexpr auto PyramidFormat = "png";
+#else
+static constexpr auto PyramidFormat = "ppm";
+#endif
+
+static void usage() {
+    std::cerr << "Usage: mandelbrot-cli [options] OUTPUT\n"
+                 "Renders the Mandelbrot set into a PPM or PNG image, OUTPUT '-' writes to stdout.\n"
+                 "  --left NUM --top NUM --right NUM --bottom NUM  view, default -2 -2 2 2\n"
+                 "  --width N --height N     image size, default 640x640\n"
+                 "  --iterations N           iteration limit, default 64\n"
+                 "  --colors N               color cycles, default 1\n"
+                 "  --from RRGGBB --to RRGGBB  blended colors, default FF0000 0000FF\n"
+                 "  --stripe N               render and write N rows at a time, bounds the memory use\n"
+                 "                           of large images, default 0 renders all rows at once\n"
+                 "  --format ppm|png         default by the OUTPUT extension, ppm for stdout\n"
+                 "  --guess                  solid guessing instead of calculating every pixel\n"
+                 "  --pyramid N              render N zoom levels of tiles into the directory OUTPUT\n"
+                 "                           as OUTPUT/z/x/y.png, level z has 2^z x 2^z tiles\n"
+                 "  --tile N                 pyramid tile size, default 256\n"
+                 "  --zoom-video N           N frames zooming from the view into its center as y4m\n"
+                 "                           video or, with --format ppm, a PPM sequence\n"
+                 "  --zoom-to RADIUS         half width of the last frame, default 1e-6\n"
+                 "  --fps N                  video frame rate, default 30\n"
+                 "  --sequence N             N frames each zoomed by --zoom-factor into the center of\n"
+                 "                           the previous, written like --zoom-video\n"
+                 "  --zoom-factor N          default 2\n"
+                 "  --save-data FILE         write also the iteration data to FILE\n"
+                 "  --cache DIR              reuse the iteration data of earlier renders stored in DIR\n"
+                 "  --cache-size MB          size limit of the cache, default 1024\n"
+                 "  --recolor FILE           color the iteration data of FILE instead of rendering,\n"
+                 "                           the view, size and iterations come from the file\n"
+                 "  --stats                  print statistics to stderr\n";
+}
+
+static std::optional<int> parseInt(const std::string& str) {
+    try {
+        size_t end;
+        const auto value = std::stoi(str, &end);
+        return end == str.size() ? std::make_optional(value) : std::nullopt;
+    } catch(...) {
+        return std::nullopt;
+    }
+}
+
+static std::optional<double> parseDouble(const std::string& str) {
+    try {
+        size_t end;
+        const auto value = std::stod(str, &end);
+        return end == str.size() ? std::make_optional(value) : std::nullopt;
+    } catch(...) {
+        return std::nullopt;
+    }
+}
+
+static std::optional<Mandelbrot::Color::type> parseColor(std::string str) {
+    if(!str.empty() && str.front() == '#')
+        str.erase(0, 1);
+    if(str.size() != 6)
+        return std::nullopt;
+    try {
+        size_t end;
+        const auto value = std::stoul(str, &end, 16);
+        if(end != str.size())
+            return std::nullopt;
+        return Mandelbrot::Color::rgba((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF);
+    } catch(...) {
+        return std::nullopt;
+    }
+}
+
+int main(int argc, char** argv) {
+#if defined(USE_MPFR)
+    Mandelbrot::MpfrPool::install();
+#endif
+    Mandelbrot::tune();
+    std::unordered_map<std::string, std::string> options {
+        {"left", "-2"}, {"top", "-2"}, {"right", "2"}, {"bottom", "2"},
+        {"width", "640"}, {"height", "640"}, {"iterations", "64"}, {"colors", "1"},
+        {"from", "FF0000"}, {"to", "0000FF"}, {"stripe", "0"}, {"format", ""},
+        {"save-data", ""}, {"recolor", ""}, {"cache", ""}, {"cache-size", "1024"},
+        {"pyramid", "0"}, {"tile", "256"},
+        {"zoom-video", "0"}, {"zoom-to", "1e-6"}, {"fps", "30"},
+        {"sequence", "0"}, {"zoom-factor", "2"}
+    };
+    bool guess = false;
+    bool stats = false;
+    std::string output;
+
+    for(auto i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if(arg == "--guess")
+            guess = true;
+        else if(arg == "--stats")
+            stats = true;
+        else if(arg == "--help" || arg == "-h") {
+            usage();
+            return 0;
+        } else if(arg.size() > 2 && arg.substr(0, 2) == "--") {
+            const auto key = arg.substr(2);
+            if(options.find(key) == options.end() || i + 1 >= argc) {
+                std::cerr << "Invalid option: " << arg << std::endl;
+                usage();
+                return 1;
+            }
+            options[key] = argv[++i];
+        } else if(output.empty())
+            output = arg;
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    Mandelbrot::IterationData data;
+    const auto recolor = !options["recolor"].empty();
+    if(recolor) {
+        if(!data.open(options["recolor"])) {
+            std::cerr << "Cannot read iteration data " << options["recolor"] << std::endl;
+            return 1;
+        }
+        options["width"] = std::to_string(data.width());
+        options["height"] = std::to_string(data.height());
+        options["iterations"] = std::to_string(data.maxIterations());
+        options["left"] = data.view()[0];
+        options["top"] = data.view()[1];
+        options["right"] = data.view()[2];
+        options["bottom"] = data.view()[3];
+    }
+
+    const auto width = parseInt(options["width"]);
+    const auto height = parseInt(options["height"]);
+    const auto iterations = parseInt(options["iterations"]);
+    const auto colors = parseInt(options["colors"]);
+    const auto from = parseColor(options["from"]);
+    const auto to = parseColor(options["to"]);
+    const auto stripe = parseInt(options["stripe"]);
+    const auto cacheSize = parseInt(options["cache-size"]);
+    const auto pyramid = parseInt(options["pyramid"]);
+    const auto tile = parseInt(options["tile"]);
+    const auto videoFrames = parseInt(options["zoom-video"]);
+    const auto fps = parseInt(options["fps"]);
+    const auto zoomTo = parseDouble(options["zoom-to"]);
+    const auto sequence = parseInt(options["sequence"]);
+    const auto zoomFactor = parseInt(options["zoom-factor"]);
+    auto format = options["format"];
+    if(format.empty())
+        format = output.size() > 4 && output.substr(output.size() - 4) == ".png" ? "png" : "ppm";
+    if(output.empty() || !width || !height || !iterations || !colors || !from || !to || !stripe || !cacheSize || !pyramid || !tile
+            || !videoFrames || !fps || !zoomTo || !sequence || !zoomFactor
+            || *width <= 0 || *height <= 0 || *iterations <= 0 || *colors <= 0 || *stripe < 0 || *cacheSize < 0
+            || *videoFrames < 0 || *fps <= 0 || *zoomTo <= 0. || *sequence < 0 || *zoomFactor < 2
+            || *pyramid < 0 || *tile <= 0 || (*pyramid > 0 && output == "-")
+            || (format != "ppm" && format != "png")) {
+        usage();
+        return 1;
+    }
+
+    for(const auto& bound : {"left", "top", "right", "bottom"}) {
+        if(!Mandelbrot::isNumber(options[bound])) { // fromString does not tell
+            std::cerr << "Invalid --" << bound << ": " << options[bound] << std::endl;
+            usage();
+            return 1;
+        }
+    }
+
+    if((*videoFrames > 0 || *sequence > 0) && format == "png") {
+        std::cerr << "Zooms are written as y4m video or, with --format ppm, as a PPM sequence, not as PNG" << std::endl;
+        return 1;
+    }
+
+    const std::array<Mandelbrot::Number, 4> view {
+        Mandelbrot::fromString(options["left"]),
+        Mandelbrot::fromString(options["top"]),
+        Mandelbrot::fromString(options["right"]),
+        Mandelbrot::fromString(options["bottom"])};
+    const auto setup = [&](MandelbrotDraw& mandelbrot) {
+        mandelbrot.setColors(*colors);
+        mandelbrot.blend(*from, *to);
+        if(guess)
+            mandelbrot.setStrategy(MandelbrotDraw::Strategy::Guessing);
+    };
+
+    if(*pyramid > 0) {
+        const auto extension = options["format"].empty() ? std::string(PyramidFormat) : format;
+#if !defined(USE_ZLIB)
+        if(extension == "png") {
+            std::cerr << "Built without PNG support" << std::endl;
+            return 1;
+        }
+#endif
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        for(auto z = 0; z < *pyramid; ++z)
+            for(auto x = 0; x < 1 << z; ++x)
+                fs::create_directories(fs::path(output) / std::to_string(z) / std::to_string(x), ec);
+        Mandelbrot::TilePyramid tiles(view, *pyramid, *tile, *iterations, setup);
+        const auto start = std::chrono::steady_clock::now();
+        const auto ok = tiles.run([&](const Mandelbrot::Image& image, int z, int x, int y) {
+            const auto path = fs::path(output) / std::to_string(z) / std::to_string(x) / (std::to_string(y) + "." + extension);
+            std::ofstream file(path, std::ios::binary);
+            std::unique_ptr<Mandelbrot::ImageWriter> writer;
+#if defined(USE_ZLIB)
+            if(extension == "png")
+                writer = std::make_unique<Mandelbrot::PngWriter>(file, image.width(), image.height(), 1);
+#endif
+            if(!writer)
+                writer = std::make_unique<Mandelbrot::PpmWriter>(file, image.width(), image.height());
+            writer->write(image);
+            return writer->ok();
+        });
+        if(!ok) {
+            std::cerr << "Cannot write tiles to " << output << std::endl;
+            return 1;
+        }
+        if(stats) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            std::cerr << "time: " << elapsed.count() << " ms, tiles: " << tiles.rendered() << "\n";
+        }
+        return 0;
+    }
+
+    std::ofstream file;
+    if(output != "-")
+        file.open(output, std::ios::binary);
+    std::ostream& out = output == "-" ? std::cout : file;
+
+    std::unique_ptr<Mandelbrot::Y4mWriter> video;
+    if((*videoFrames > 0 || *sequence > 0) && options["format"] != "ppm")
+        video = std::make_unique<Mandelbrot::Y4mWriter>(out, *width, *height, *fps);
+    const auto writeFrame = [&](const Mandelbrot::Image& image) {
+        if(video)
+            video->write(image);
+        else
+            Mandelbrot::PpmWriter(out, *width, *height).write(image);
+        if(!out.good())
+            std::cerr << "Cannot write " << output << std::endl;
+        return out.good();
+    };
+
+    if(*videoFrames > 0) {
+        const auto re = (view[0] + view[2]) / Mandelbrot::Number(2);
+        const auto im = (view[1] + view[3]) / Mandelbrot::Number(2);
+        const auto startRadius = std::abs(Mandelbrot::toDouble(view[2] - view[0])) / 2.;
+        // the first frame corners and the last frame center pixel bound the map
+        const auto outer = startRadius * std::hypot(*width, *height) / *width;
+        const auto inner = *zoomTo / (2. * *width);
+        Mandelbrot::ExpMap map(re, im, outer, inner, Mandelbrot::ExpMap::columnsFor(*width), *iterations);
+        const auto start = std::chrono::steady_clock::now();
+        map.render();
+        const auto rendered = std::chrono::steady_clock::now();
+        const Mandelbrot::Palette palette(*iterations, *colors, *from, *to);
+        Mandelbrot::Image image(*width, *height);
+        for(auto f = 0; f < *videoFrames; ++f) {
+            const auto t = *videoFrames > 1 ? static_cast<double>(f) / (*videoFrames - 1) : 0.;
+            map.frame(startRadius * std::pow(*zoomTo / startRadius, t), palette, image);
+            if(!writeFrame(image))
+                return 1;
+        }
+        if(stats) {
+            const auto now = std::chrono::steady_clock::now();
+            std::cerr << "map: " << map.columns() << "x" << map.rows() << " in "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(rendered - start).count() << " ms, "
+                      << *videoFrames << " frames in " << std::chrono::duration_cast<std::chrono::milliseconds>(now - rendered).count() << " ms\n";
+        }
+        return 0;
+    }
+
+    if(*sequence > 0) {
+        Mandelbrot::ZoomSequence frames((view[0] + view[2]) / Mandelbrot::Number(2),
+                                        (view[1] + view[3]) / Mandelbrot::Number(2),
+                                        (view[2] - view[0]) / Mandelbrot::Number(2),
+                                        *width, *height, *iterations, *zoomFactor, setup);
+        const auto start = std::chrono::steady_clock::now();
+        if(!frames.run(*sequence, [&writeFrame](const Mandelbrot::Image& image, int) {return writeFrame(image);}))
+            return 1;
+        if(stats) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            const auto g = frames.guessStats();
+            std::cerr << "time: " << elapsed.count() << " ms\n"
+                      << "computed: " << g.computed << " guessed: " << g.guessed << " corrected: " << g.corrected << " reused: " << g.reused << "\n";
+        }
+        return 0;
+    }
+
+    std::unique_ptr<Mandelbrot::ImageWriter> writer;
+    std::function<std::chrono::microseconds ()> encodeTime; // compression of PNG, not in the writing time
+    if(format == "png") {
+#if defined(USE_ZLIB)
+        auto png = std::make_unique<Mandelbrot::PngWriter>(out, *width, *height);
+        encodeTime = [p = png.get()]() {return p->encodeTime();};
+        writer = std::move(png);
+#else
+        std::cerr << "Built without PNG support" << std::endl;
+        return 1;
+#endif
+    } else
+        writer = std::make_unique<Mandelbrot::PpmWriter>(out, *width, *height);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::microseconds writing{0};
+    const auto write = [&writer, &out, &writing](const Mandelbrot::Image& image) {
+        const auto writeStart = std::chrono::steady_clock::now();
+        writer->write(image);
+        out.flush();
+        writing += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - writeStart);
+        return writer->ok();
+    };
+    const auto printTime = [&writing, &encodeTime](std::chrono::milliseconds elapsed) {
+        std::cerr << "time: " << elapsed.count() << " ms, of which writing " << writing.count() / 1000 << " ms";
+        if(encodeTime)
+            std::cerr << ", encoding " << encodeTime().count() / 1000 << " ms";
+        std::cerr << "\n";
+    };
+
+    if(recolor) {
+        const Mandelbrot::Palette palette(*iterations, *colors, *from, *to);
+        const auto rows = *stripe > 0 ? std::min(*stripe, *height) : *height;
+        Mandelbrot::Image image;
+        for(auto y = 0; y < *height; y += rows) {
+            const auto count = std::min(rows, *height - y);
+            if(image.height() != count)
+                image.create(*width, count);
+            for(auto r = 0; r < count; ++r)
+                palette.apply(data.iterations(y + r), image.row(r), *width);
+            if(!write(image)) {
+                std::cerr << "Cannot write " << output << std::endl;
+                return 1;
+            }
+        }
+        if(stats) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            printTime(elapsed);
+        }
+        return 0;
+    }
+
+    Mandelbrot::StripedRender render(view, *width, *height, *iterations, *stripe, setup);
+
+    const std::array<std::string, 4> viewStrings {options["left"], options["top"], options["right"], options["bottom"]};
+    std::unique_ptr<Mandelbrot::TileCache> cache;
+    if(!options["cache"].empty()) {
+        cache = std::make_unique<Mandelbrot::TileCache>(options["cache"], static_cast<uintmax_t>(*cacheSize) * 1024 * 1024);
+        if(!cache->ok())
+            std::cerr << "Cannot use cache " << options["cache"] << std::endl;
+        render.setCache(cache.get(), viewStrings);
+    }
+
+    std::unique_ptr<Mandelbrot::IterationWriter> dataWriter;
+    if(!options["save-data"].empty())
+        dataWriter = std::make_unique<Mandelbrot::IterationWriter>(options["save-data"],
+            viewStrings, *width, *height, *iterations);
+
+#if defined(USE_MPFR)
+    Mandelbrot::MpfrPool::resetStats(); // once for all the stripes, they overlap
+#endif
+    const auto ok = render.run([&write, &dataWriter](const Mandelbrot::Image& image, const Mandelbrot::FrameBuffer& frame, int) {
+        if(dataWriter) {
+            dataWriter->write(frame);
+            if(!dataWriter->ok())
+                return false;
+        }
+        return write(image);
+    });
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    if(!ok) {
+        std::cerr << "Cannot write " << (dataWriter && !dataWriter->ok() ? options["save-data"] : output) << std::endl;
+        return 1;
+    }
+
+    if(stats) {
+        const auto g = render.guessStats();
+        printTime(elapsed);
+        std::cerr << "computed: " << g.computed << " guessed: " << g.guessed << " corrected: " << g.corrected << "\n";
+        if(cache) {
+            const auto c = cache->stats();
+            std::cerr << "cache hits: " << c.hits << " misses: " << c.misses << " evicted: " << c.evicted << "\n";
+        }
+#if defined(USE_MPFR)
+        const auto p = Mandelbrot::MpfrPool::stats();
+        std::cerr << "allocations: " << p.allocations << " system: " << p.systemAllocations << " peak bytes: " << p.peakBytes << "\n";
+#endif
+    }
+    return 0;
+}
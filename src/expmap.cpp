@@ -0,0 +1,88 @@
+#include "expmap.h"
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace Mandelbrot;
+
+static constexpr double Pi = 3.14159265358979323846;
+
+ExpMap::ExpMap(const Number& re, const Number& im, double outerRadius, double innerRadius, int columns, int iterations) :
+    m_re(re), m_im(im), m_outer(outerRadius), m_columns(columns),
+    m_rows(static_cast<int>(std::ceil(std::log(outerRadius / innerRadius) * columns / (2. * Pi))) + 2),
+    m_iterations(iterations),
+    m_values(static_cast<size_t>(m_rows) * static_cast<size_t>(m_columns)) {
+}
+
+int ExpMap::columnsFor(int width) {
+    // at the frame edge a column is 2pi r / columns wide and a pixel 2r / width
+    return static_cast<int>(std::ceil(Pi * width));
+}
+
+void ExpMap::render(unsigned threads) {
+    if(threads == 0)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<double> cosines(static_cast<size_t>(m_columns));
+    std::vector<double> sines(cosines.size());
+    for(auto j = 0; j < m_columns; ++j) {
+        cosines[static_cast<size_t>(j)] = std::cos(2. * Pi * j / m_columns);
+        sines[static_cast<size_t>(j)] = std::sin(2. * Pi * j / m_columns);
+    }
+    std::atomic_int next{0};
+    const ThreadSettings settings;
+    const auto worker = [&]() {
+        settings.apply();
+        for(auto k = next++; k < m_rows; k = next++) {
+            const auto radius = m_outer * std::exp(-2. * Pi * k / m_columns);
+            auto values = &m_values[static_cast<size_t>(k) * static_cast<size_t>(m_columns)];
+            for(auto j = 0; j < m_columns; ++j) {
+                const Complex c(m_re + Number(radius * cosines[static_cast<size_t>(j)]),
+                                m_im + Number(radius * sines[static_cast<size_t>(j)]));
+                float fraction;
+                const auto n = calculate(c, m_iterations, &fraction);
+                values[j] = n < m_iterations ? static_cast<float>(n) + fraction : -1.f;
+            }
+        }
+    };
+    std::vector<std::future<void>> workers;
+    for(auto t = 0U; t < threads; ++t)
+        workers.push_back(std::async(std::launch::async, worker));
+    for(auto& w : workers)
+        w.wait();
+}
+
+float ExpMap::sample(double row, double column) const {
+    row = std::min(std::max(row, 0.), static_cast<double>(m_rows - 1));
+    const auto k0 = std::min(static_cast<int>(row), m_rows - 2);
+    const auto j0 = static_cast<int>(column) % m_columns;
+    const auto j1 = (j0 + 1) % m_columns;
+    const auto fk = static_cast<float>(row - k0);
+    const auto fj = static_cast<float>(column - std::floor(column));
+    const auto v00 = value(k0, j0);
+    const auto v01 = value(k0, j1);
+    const auto v10 = value(k0 + 1, j0);
+    const auto v11 = value(k0 + 1, j1);
+    if(v00 < 0 || v01 < 0 || v10 < 0 || v11 < 0) // no blending over the set boundary
+        return value(fk < .5f ? k0 : k0 + 1, fj < .5f ? j0 : j1);
+    return (v00 * (1 - fj) + v01 * fj) * (1 - fk) + (v10 * (1 - fj) + v11 * fj) * fk;
+}
+
+void ExpMap::frame(double radius, const Palette& palette, Image& image) const {
+    const auto scale = 2. * radius / image.width();
+    const auto rowsPerLog = m_columns / (2. * Pi);
+    const auto columnsPerAngle = m_columns / (2. * Pi);
+    for(auto y = 0; y < image.height(); ++y) {
+        const auto dy = (y + .5 - image.height() / 2.) * scale;
+        auto row = image.row(y);
+        for(auto x = 0; x < image.width(); ++x) {
+            const auto dx = (x + .5 - image.width() / 2.) * scale;
+            const auto r = std::hypot(dx, dy);
+            auto angle = std::atan2(dy, dx);
+            if(angle < 0)
+                angle += 2. * Pi;
+            const auto v = sample(std::log(m_outer / r) * rowsPerLog, angle * columnsPerAngle);
+            row[x] = palette(v < 0 ? -1 : static_cast<int>(v));
+        }
+    }
+}
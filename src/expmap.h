@@ -0,0 +1,51 @@
+#ifndef EXPMAP_H
+#define EXPMAP_H
+
+#include "mandelbrot.h"
+#include "image.h"
+#include "palette.h"
+
+#include <vector>
+
+namespace Mandelbrot {
+
+/// Exponential map of a zoom: the plane around a center sampled in log-polar coordinates,
+/// row k at radius outer * exp(-k * 2pi / columns) and column j at angle j * 2pi / columns,
+/// so that samples are square at every radius. The map is calculated once and each frame
+/// of the zoom is resampled from it. The center is in full precision and the offsets from it
+/// in double, so the radii can go down to the resolution of Number at the center, about
+/// 1e-60 times its magnitude with MPFR and 1e-16 times with double.
+class ExpMap {
+public:
+    /// Columns around the circle, rows follow from the radii
+    ExpMap(const Number& re, const Number& im, double outerRadius, double innerRadius, int columns, int iterations);
+
+    /// Columns needed so that a frame of the width is not undersampled at its edges
+    static int columnsFor(int width);
+
+    int columns() const {return m_columns;}
+    int rows() const {return m_rows;}
+
+    /// Calculate the map on all cores
+    void render(unsigned threads = 0);
+
+    /// Resample a frame of a square pixel view centered at the center, radius is half of its width
+    void frame(double radius, const Palette& palette, Image& image) const;
+
+private:
+    /// Continuous iteration count n + fraction, negative inside the set
+    float value(int row, int column) const {return m_values[static_cast<size_t>(row) * static_cast<size_t>(m_columns) + static_cast<size_t>(column)];}
+    float sample(double row, double column) const;
+private:
+    const Number m_re;
+    const Number m_im;
+    const double m_outer;
+    const int m_columns;
+    const int m_rows;
+    const int m_iterations;
+    std::vector<float> m_values;
+};
+
+}
+
+#endif // EXPMAP_H
@@ -0,0 +1,139 @@
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+
+namespace Mandelbrot {
+
+/// Two's complement fixed point number of Limbs 32 bit limbs, the most significant first.
+/// The first limb is the integer part and the rest is the fraction. The number of limbs is
+/// a compile time constant, so the loops over them are unrolled and nothing is allocated or
+/// normalized, which suits the iteration where the values stay small.
+template <int Limbs>
+class FixedPoint {
+    static_assert(Limbs >= 2, "FixedPoint needs an integer and a fraction limb");
+public:
+    static constexpr int FractionBits = 32 * (Limbs - 1);
+    FixedPoint() : m_limbs{} {}
+    explicit FixedPoint(int value) : m_limbs{} {m_limbs[0] = static_cast<uint32_t>(value);}
+
+    uint32_t& limb(int k) {return m_limbs[static_cast<size_t>(k)];}
+    uint32_t limb(int k) const {return m_limbs[static_cast<size_t>(k)];}
+
+    bool negative() const {return (m_limbs[0] & 0x80000000U) != 0;}
+
+    FixedPoint& operator+=(const FixedPoint& other) {
+        uint64_t carry = 0;
+        for(auto k = Limbs - 1; k >= 0; --k) {
+            const auto t = static_cast<uint64_t>(limb(k)) + other.limb(k) + carry;
+            limb(k) = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        return *this;
+    }
+
+    FixedPoint& operator-=(const FixedPoint& other) {
+        uint64_t borrow = 0;
+        for(auto k = Limbs - 1; k >= 0; --k) {
+            const auto t = static_cast<uint64_t>(limb(k)) - other.limb(k) - borrow;
+            limb(k) = static_cast<uint32_t>(t);
+            borrow = (t >> 32) & 0x1;
+        }
+        return *this;
+    }
+
+    FixedPoint operator-() const {
+        FixedPoint out;
+        out -= *this;
+        return out;
+    }
+
+    /// Product rounded to the nearest
+    FixedPoint operator*(const FixedPoint& other) const {
+        const auto a = abs();
+        const auto b = other.abs();
+        uint32_t r[2 * Limbs] = {}; // r[k] weighs 2^(32 * (1 - k)), r[1] is the integer part
+        for(auto i = Limbs - 1; i >= 0; --i) {
+            uint64_t carry = 0;
+            for(auto j = Limbs - 1; j >= 0; --j) {
+                const auto t = static_cast<uint64_t>(a.limb(i)) * b.limb(j) + r[i + j + 1] + carry;
+                r[i + j + 1] = static_cast<uint32_t>(t);
+                carry = t >> 32;
+            }
+            r[i] = static_cast<uint32_t>(carry);
+        }
+        const auto out = rounded(r);
+        return negative() != other.negative() ? -out : out;
+    }
+
+    /// Square rounded to the nearest, each cross product is calculated once and doubled
+    FixedPoint sqr() const {
+        const auto a = abs();
+        uint32_t r[2 * Limbs] = {};
+        for(auto i = Limbs - 1; i >= 0; --i) {
+            uint64_t carry = 0;
+            for(auto j = Limbs - 1; j > i; --j) {
+                const auto t = static_cast<uint64_t>(a.limb(i)) * a.limb(j) + r[i + j + 1] + carry;
+                r[i + j + 1] = static_cast<uint32_t>(t);
+                carry = t >> 32;
+            }
+            r[i + i + 1] = static_cast<uint32_t>(carry);
+        }
+        uint64_t carry = 0;
+        for(auto k = 2 * Limbs - 1; k >= 0; --k) {
+            const auto t = (static_cast<uint64_t>(r[k]) << 1) + carry;
+            r[k] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        carry = 0;
+        for(auto i = Limbs - 1; i >= 0; --i) {
+            auto t = static_cast<uint64_t>(a.limb(i)) * a.limb(i) + r[2 * i + 1] + carry;
+            r[2 * i + 1] = static_cast<uint32_t>(t);
+            t = (t >> 32) + r[2 * i];
+            r[2 * i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        return rounded(r);
+    }
+
+    bool operator<=(const FixedPoint& other) const {
+        if(limb(0) != other.limb(0))
+            return static_cast<int32_t>(limb(0)) < static_cast<int32_t>(other.limb(0));
+        for(auto k = 1; k < Limbs; ++k)
+            if(limb(k) != other.limb(k))
+                return limb(k) < other.limb(k);
+        return true;
+    }
+
+    double toDouble() const {
+        const auto a = abs();
+        auto d = 0.;
+        for(auto k = Limbs - 1; k >= 0; --k)
+            d = d / 4294967296. + a.limb(k);
+        return negative() ? -d : d;
+    }
+
+private:
+    FixedPoint abs() const {return negative() ? -*this : *this;}
+
+    static FixedPoint rounded(const uint32_t* r) {
+        FixedPoint out;
+        for(auto k = 0; k < Limbs; ++k)
+            out.limb(k) = r[k + 1];
+        if(r[Limbs + 1] & 0x80000000U) {
+            FixedPoint ulp;
+            ulp.limb(Limbs - 1) = 1;
+            out += ulp;
+        }
+        return out;
+    }
+
+private:
+    std::array<uint32_t, Limbs> m_limbs;
+};
+
+}
+
+#endif // FIXEDPOINT_H
@@ -0,0 +1,66 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace Mandelbrot {
+
+/// Per pixel results of a frame, stored as a structure of arrays so
+/// that rows are filled in blocks and iteration counts stay compact.
+class FrameBuffer {
+public:
+    enum Flags : uint8_t {
+        None = 0x0,
+        Computed = 0x1,
+        Guessed = 0x2,
+        Mirrored = 0x4,
+        Corrected = 0x8,
+        Cached = 0x10
+    };
+
+    void resize(int width, int height) {
+        m_width = width;
+        m_height = height;
+        const auto size = static_cast<size_t>(width) * static_cast<size_t>(height);
+        m_iterations.assign(size, 0);
+        m_fractions.assign(size, 0.f);
+        m_flags.assign(size, None);
+    }
+
+    int width() const {return m_width;}
+    int height() const {return m_height;}
+
+    int* iterations(int y) {return m_iterations.data() + offset(y);}
+    float* fractions(int y) {return m_fractions.data() + offset(y);}
+    uint8_t* flags(int y) {return m_flags.data() + offset(y);}
+
+    const int* iterations(int y) const {return m_iterations.data() + offset(y);}
+    const float* fractions(int y) const {return m_fractions.data() + offset(y);}
+    const uint8_t* flags(int y) const {return m_flags.data() + offset(y);}
+
+    int iteration(int x, int y) const {return iterations(y)[x];}
+    float fraction(int x, int y) const {return fractions(y)[x];}
+    uint8_t flag(int x, int y) const {return flags(y)[x];}
+
+    /// Copy a row to its mirror image
+    void mirror(int from, int to) {
+        std::copy_n(iterations(from), m_width, iterations(to));
+        std::copy_n(fractions(from), m_width, fractions(to));
+        std::fill_n(flags(to), m_width, Mirrored);
+    }
+
+private:
+    size_t offset(int y) const {return static_cast<size_t>(y) * static_cast<size_t>(m_width);}
+private:
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<int> m_iterations;
+    std::vector<float> m_fractions;
+    std::vector<uint8_t> m_flags;
+};
+
+}
+
+#endif // FRAMEBUFFER_H
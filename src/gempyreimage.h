@@ -0,0 +1,28 @@
+#ifndef GEMPYREIMAGE_H
+#define GEMPYREIMAGE_H
+
+#include "image.h"
+#include <gempyre_graphics.h>
+
+/// Gempyre adapter of the rendered images, the core library does not depend on Gempyre
+namespace Mandelbrot {
+
+    inline Gempyre::Color::type toPixel(Color::type c) {
+        return Gempyre::Bitmap::pix(Color::r(c), Color::g(c), Color::b(c), Color::alpha(c));
+    }
+
+    /// Copy rows [top, top + rows) of the image to the same rows of the bitmap
+    inline void toBitmap(const Image& image, int top, int rows, Gempyre::Bitmap& bitmap, int bitmapTop) {
+        for(auto y = 0; y < rows; ++y) {
+            const auto row = image.row(top + y);
+            for(auto x = 0; x < image.width(); ++x)
+                bitmap.set_pixel(x, bitmapTop + y, toPixel(row[x]));
+        }
+    }
+
+    inline void toBitmap(const Image& image, Gempyre::Bitmap& bitmap) {
+        toBitmap(image, 0, image.height(), bitmap, 0);
+    }
+}
+
+#endif // GEMPYREIMAGE_H
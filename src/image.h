@@ -0,0 +1,51 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Mandelbrot {
+
+/// Colors are packed as RGBA bytes in memory order, the same as Gempyre uses
+namespace Color {
+    using type = uint32_t;
+    constexpr type rgba(type r, type g, type b, type a = 0xFF) {return (r & 0xFF) | ((g & 0xFF) << 8) | ((b & 0xFF) << 16) | ((a & 0xFF) << 24);}
+    constexpr type r(type c) {return c & 0xFF;}
+    constexpr type g(type c) {return (c >> 8) & 0xFF;}
+    constexpr type b(type c) {return (c >> 16) & 0xFF;}
+    constexpr type alpha(type c) {return (c >> 24) & 0xFF;}
+    constexpr type Black = rgba(0, 0, 0);
+    constexpr type White = rgba(0xFF, 0xFF, 0xFF);
+    constexpr type Red = rgba(0xFF, 0, 0);
+    constexpr type Green = rgba(0, 0xFF, 0);
+    constexpr type Blue = rgba(0, 0, 0xFF);
+}
+
+/// Plain pixel buffer the renderer draws into
+class Image {
+public:
+    Image() = default;
+    Image(int width, int height) {create(width, height);}
+    void create(int width, int height) {
+        m_width = width;
+        m_height = height;
+        m_pixels.assign(static_cast<size_t>(width) * static_cast<size_t>(height), Color::Black);
+    }
+    int width() const {return m_width;}
+    int height() const {return m_height;}
+    void set_pixel(int x, int y, Color::type color) {m_pixels[offset(x, y)] = color;}
+    Color::type pixel(int x, int y) const {return m_pixels[offset(x, y)];}
+    Color::type* row(int y) {return m_pixels.data() + offset(0, y);}
+    const Color::type* row(int y) const {return m_pixels.data() + offset(0, y);}
+private:
+    size_t offset(int x, int y) const {return static_cast<size_t>(y) * static_cast<size_t>(m_width) + static_cast<size_t>(x);}
+private:
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<Color::type> m_pixels;
+};
+
+}
+
+#endif // IMAGE_H
@@ -0,0 +1,86 @@
+#ifndef IMAGEWRITER_H
+#define IMAGEWRITER_H
+
+#include "image.h"
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+namespace Mandelbrot {
+
+/// Writes an image in row order, a part of rows at a time
+class ImageWriter {
+public:
+    virtual ~ImageWriter() = default;
+    /// Next rows of the image
+    virtual void write(const Image& rows) = 0;
+    virtual bool ok() const = 0;
+};
+
+/// Binary PPM (P6), rows are written in order as they come
+class PpmWriter : public ImageWriter {
+public:
+    PpmWriter(std::ostream& out, int width, int height) : m_out(out), m_bytes(static_cast<size_t>(width) * 3) {
+        m_out << "P6\n" << width << " " << height << "\n255\n";
+    }
+
+    void write(const Color::type* row) {
+        auto p = m_bytes.begin();
+        for(auto x = 0U; x < m_bytes.size(); x += 3, ++row) {
+            *p++ = static_cast<char>(Color::r(*row));
+            *p++ = static_cast<char>(Color::g(*row));
+            *p++ = static_cast<char>(Color::b(*row));
+        }
+        m_out.write(m_bytes.data(), static_cast<std::streamsize>(m_bytes.size()));
+    }
+
+    void write(const Image& image) override {
+        for(auto y = 0; y < image.height(); ++y)
+            write(image.row(y));
+    }
+
+    bool ok() const override {return m_out.good();}
+private:
+    std::ostream& m_out;
+    std::vector<char> m_bytes;
+};
+
+/// YUV4MPEG2 video in 4:4:4, a whole frame per write, converted with BT.601 studio swing
+class Y4mWriter {
+public:
+    Y4mWriter(std::ostream& out, int width, int height, int fps) : m_out(out), m_plane(static_cast<size_t>(width) * static_cast<size_t>(height)) {
+        m_out << "YUV4MPEG2 W" << width << " H" << height << " F" << fps << ":1 Ip A1:1 C444\n";
+    }
+
+    void write(const Image& frame) {
+        std::vector<unsigned char> yuv(m_plane * 3);
+        auto p = 0U;
+        for(auto y = 0; y < frame.height(); ++y) {
+            const auto row = frame.row(y);
+            for(auto x = 0; x < frame.width(); ++x, ++p) {
+                const auto r = static_cast<double>(Color::r(row[x]));
+                const auto g = static_cast<double>(Color::g(row[x]));
+                const auto b = static_cast<double>(Color::b(row[x]));
+                yuv[p] = byte(16. + (65.481 * r + 128.553 * g + 24.966 * b) / 255.);
+                yuv[p + m_plane] = byte(128. + (-37.797 * r - 74.203 * g + 112. * b) / 255.);
+                yuv[p + 2 * m_plane] = byte(128. + (112. * r - 93.786 * g - 18.214 * b) / 255.);
+            }
+        }
+        m_out << "FRAME\n";
+        m_out.write(reinterpret_cast<const char*>(yuv.data()), static_cast<std::streamsize>(yuv.size()));
+    }
+
+    bool ok() const {return m_out.good();}
+private:
+    static unsigned char byte(double v) {
+        return static_cast<unsigned char>(std::min(255L, std::max(0L, std::lround(v))));
+    }
+private:
+    std::ostream& m_out;
+    const size_t m_plane;
+};
+
+}
+
+#endif // IMAGEWRITER_H
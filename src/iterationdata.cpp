@@ -0,0 +1,141 @@
+#include "iterationdata.h"
+
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Mandelbrot;
+
+static_assert(sizeof(int) == sizeof(int32_t), "FrameBuffer iterations are stored as int32");
+
+static size_t headerSize(const IterationFile::Header& header) {
+    auto size = sizeof(IterationFile::Header);
+    for(const auto length : header.viewLength)
+        size += length;
+    return IterationFile::align(size);
+}
+
+static size_t arraySize(const IterationFile::Header& header) {
+    return IterationFile::align(static_cast<size_t>(header.width) * header.height * 4);
+}
+
+IterationWriter::IterationWriter(const std::string& path, const std::array<std::string, 4>& view, int width, int height, int iterations) :
+    m_out(path, std::ios::binary), m_width(width), m_height(height) {
+    IterationFile::Header header = {};
+    std::memcpy(header.magic, IterationFile::Magic, sizeof(header.magic));
+    header.version = IterationFile::Version;
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.iterations = static_cast<uint32_t>(iterations);
+    header.flags = IterationFile::None;
+    for(auto i = 0U; i < view.size(); ++i)
+        header.viewLength[i] = static_cast<uint32_t>(view[i].size());
+    m_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(const auto& v : view)
+        m_out.write(v.data(), static_cast<std::streamsize>(v.size()));
+    m_iterationsOffset = headerSize(header);
+    m_fractionsOffset = m_iterationsOffset + arraySize(header);
+    // the file gets its full size up front, rows are then written in place
+    const auto end = m_fractionsOffset + arraySize(header);
+    m_out.seekp(static_cast<std::streamoff>(end - 1));
+    m_out.put('\0');
+}
+
+void IterationWriter::write(const FrameBuffer& rows) {
+    if(rows.width() != m_width || m_rows + rows.height() > m_height) {
+        m_rows = m_height + 1;
+        return;
+    }
+    const auto rowOffset = static_cast<size_t>(m_rows) * static_cast<size_t>(m_width) * 4;
+    const auto bytes = static_cast<std::streamsize>(static_cast<size_t>(rows.width()) * static_cast<size_t>(rows.height()) * 4);
+    if(bytes == 0)
+        return;
+    m_out.seekp(static_cast<std::streamoff>(m_iterationsOffset + rowOffset));
+    m_out.write(reinterpret_cast<const char*>(rows.iterations(0)), bytes);
+    m_out.seekp(static_cast<std::streamoff>(m_fractionsOffset + rowOffset));
+    m_out.write(reinterpret_cast<const char*>(rows.fractions(0)), bytes);
+    m_rows += rows.height();
+}
+
+IterationData::~IterationData() {
+    close();
+}
+
+void IterationData::close() {
+#if !defined(_WIN32)
+    if(m_mapped)
+        ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+    m_mapped = false;
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_header = {};
+}
+
+bool IterationData::open(const std::string& path) {
+    close();
+#if !defined(_WIN32)
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if(::fstat(fd, &st) == 0 && st.st_size > 0) {
+        const auto ptr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if(ptr != MAP_FAILED) {
+            m_data = static_cast<const char*>(ptr);
+            m_size = static_cast<size_t>(st.st_size);
+            m_mapped = true;
+        }
+    }
+    ::close(fd);
+#endif
+    if(!m_mapped) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if(!in)
+            return false;
+        m_buffer.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        if(!in)
+            return false;
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    if(m_size < sizeof(IterationFile::Header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    if(std::memcmp(m_header.magic, IterationFile::Magic, sizeof(m_header.magic)) != 0 || m_header.version != IterationFile::Version) {
+        close();
+        return false;
+    }
+    const auto arrays = (m_header.flags & IterationFile::HasDistance) ? 3U : 2U;
+    auto viewLength = size_t(0);
+    for(const auto length : m_header.viewLength)
+        viewLength += length;
+    if(viewLength > m_size || headerSize(m_header) + arraySize(m_header) * arrays > m_size) {
+        close();
+        return false;
+    }
+    auto p = m_data + sizeof(IterationFile::Header);
+    for(auto i = 0U; i < m_view.size(); ++i) {
+        m_view[i].assign(p, m_header.viewLength[i]);
+        p += m_header.viewLength[i];
+    }
+    m_iterations = headerSize(m_header);
+    m_fractions = m_iterations + arraySize(m_header);
+    m_distances = arrays > 2 ? m_fractions + arraySize(m_header) : 0;
+#if !defined(_WIN32)
+    if(m_mapped)
+        ::madvise(const_cast<char*>(m_data), m_size, MADV_SEQUENTIAL);
+#endif
+    return true;
+}
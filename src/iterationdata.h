@@ -0,0 +1,97 @@
+#ifndef ITERATIONDATA_H
+#define ITERATIONDATA_H
+
+#include "framebuffer.h"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Mandelbrot {
+
+/// Raw per pixel results of a frame on disk, recolored later without calculating a single orbit.
+/// A file is the header, the view as exact decimal strings and then row major arrays of int32
+/// iteration counts, float fractions and optionally float distance estimates, each array starting
+/// at a multiple of 8 bytes. Values are in the native byte order.
+namespace IterationFile {
+    constexpr char Magic[4] = {'M', 'B', 'I', 'T'};
+    constexpr uint32_t Version = 1;
+    enum Flags : uint32_t {
+        None = 0x0,
+        HasDistance = 0x1
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t iterations;
+        uint32_t flags;
+        uint32_t viewLength[4];  // left, top, right, bottom
+    };
+
+    inline size_t align(size_t offset) {return (offset + 7) & ~size_t(7);}
+}
+
+/// Writes iteration data in row order, rows may come a stripe at a time
+class IterationWriter {
+public:
+    IterationWriter(const std::string& path, const std::array<std::string, 4>& view, int width, int height, int iterations);
+    /// Next rows of the frame, all rows of the buffer are written
+    void write(const FrameBuffer& rows);
+    bool ok() const {return m_out.good() && m_rows <= m_height;}
+private:
+    std::ofstream m_out;
+    const int m_width;
+    const int m_height;
+    size_t m_iterationsOffset = 0;
+    size_t m_fractionsOffset = 0;
+    int m_rows = 0;
+};
+
+/// Read only view to an iteration data file, memory mapped where available so
+/// that only the rows actually touched are read from the disk.
+class IterationData {
+public:
+    IterationData() = default;
+    ~IterationData();
+    IterationData(const IterationData&) = delete;
+    IterationData& operator=(const IterationData&) = delete;
+
+    /// False if the file cannot be read or is not valid iteration data
+    bool open(const std::string& path);
+    void close();
+
+    int width() const {return static_cast<int>(m_header.width);}
+    int height() const {return static_cast<int>(m_header.height);}
+    int maxIterations() const {return static_cast<int>(m_header.iterations);}
+    /// left, top, right, bottom as they were given to the renderer
+    const std::array<std::string, 4>& view() const {return m_view;}
+
+    const int32_t* iterations(int y) const {return row<int32_t>(m_iterations, y);}
+    const float* fractions(int y) const {return row<float>(m_fractions, y);}
+    /// nullptr if the file has no distance estimates
+    const float* distances(int y) const {return m_distances ? row<float>(m_distances, y) : nullptr;}
+
+private:
+    template <class T> const T* row(size_t offset, int y) const {
+        return reinterpret_cast<const T*>(m_data + offset) + static_cast<size_t>(y) * m_header.width;
+    }
+private:
+    IterationFile::Header m_header = {};
+    std::array<std::string, 4> m_view;
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    std::vector<char> m_buffer;  // used when the file cannot be mapped
+    size_t m_iterations = 0;
+    size_t m_fractions = 0;
+    size_t m_distances = 0;
+};
+
+}
+
+#endif // ITERATIONDATA_H
@@ -6,8 +6,15 @@
 #include "mandelbrot_resource.h"
 
 #include "mandelbrotdraw.h"
+#include "gempyreimage.h"
+
+#include <optional>
 
 int main(int argc, char** argv) {
+#if defined(USE_MPFR)
+    Mandelbrot::MpfrPool::install();
+#endif
+    Mandelbrot::tune();
     Gempyre::set_debug();
 
     Gempyre::Ui ui(Mandelbrot_resourceh,
@@ -17,19 +24,20 @@ int main(int argc, char** argv) {
     Gempyre::Element colors(ui, "color_slider");
     Gempyre::Element radius(ui, "radius");
     Gempyre::Element zooms(ui, "zooms");
-    Gempyre::Bitmap graphics;
-    Gempyre::Bitmap backupGraphics;
-    Gempyre::Bitmap blend;
+    Gempyre::Bitmap graphics;   // the rendered image without the selection
+    Mandelbrot::Image image;
     Gempyre::Element busy(ui, "busy");
 
     bool mousedown = false;
     int mousex;
     int mousey;
+    std::optional<Gempyre::Element::Rect> selection; // as shown on the canvas
+    std::mutex canvasMutex;
 
     std::unique_ptr<MandelbrotDraw> mandelbrot;
     std::vector<std::array<Mandelbrot::Number, 4>> coordinateStack;
 
-    const auto updater = [&graphics, &busy, &canvas](int c, int a) {
+    const auto updater = [&busy](int c, int a) {
         if(c == 0) {
             busy.set_attribute("style", "display:inline");
         }
@@ -38,10 +46,40 @@ int main(int argc, char** argv) {
         }
         if(c == a) {
             busy.set_attribute("style", "display:none");
-            canvas.draw(graphics);
         }
     };
 
+    // only the finished rows are sent to the canvas
+    const auto rowsDrawn = [&graphics, &image, &canvas, &canvasMutex](int y, int rows) {
+        std::lock_guard<std::mutex> lock(canvasMutex);
+        Mandelbrot::toBitmap(image, y, rows, graphics, y);
+        Gempyre::Bitmap part(image.width(), rows);
+        Mandelbrot::toBitmap(image, y, rows, part, 0);
+        canvas.draw(0, y, part);
+    };
+
+    // selection is shown as is and the rest shaded
+    const auto drawSelection = [&graphics, &canvas, &canvasMutex](const Gempyre::Element::Rect& area, const Gempyre::Element::Rect& selected) {
+        std::lock_guard<std::mutex> lock(canvasMutex);
+        constexpr Gempyre::Color::type shade = 0x73;
+        constexpr Gempyre::Color::type alpha = 0x83;
+        const auto blend = [](Gempyre::Color::type c) {return (c * (0xFF - alpha) + shade * alpha) / 0xFF;};
+        Gempyre::Bitmap part(area.width, area.height);
+        for(auto y = 0; y < area.height; ++y) {
+            const auto py = area.y + y;
+            const auto rowSelected = py >= selected.y && py < selected.y + selected.height;
+            for(auto x = 0; x < area.width; ++x) {
+                const auto px = area.x + x;
+                const auto c = graphics.pixel(px, py);
+                if(rowSelected && px >= selected.x && px < selected.x + selected.width)
+                    part.set_pixel(x, y, c);
+                else
+                    part.set_pixel(x, y, Gempyre::Bitmap::pix(blend(Gempyre::Color::r(c)), blend(Gempyre::Color::g(c)), blend(Gempyre::Color::b(c))));
+            }
+        }
+        canvas.draw(area.x, area.y, part);
+    };
+
     auto rect = *canvas.rect();
 
     ui.set_logging(true);
@@ -69,39 +107,50 @@ int main(int argc, char** argv) {
             mandelbrot->update(updater);
         }, {"value"});
 
-        canvas.subscribe("mousedown", [&mousex, &mousey, &mousedown, &rect, &graphics, &backupGraphics] (const Gempyre::Event& ev) {
+        canvas.subscribe("mousedown", [&mousex, &mousey, &mousedown, &rect, &selection] (const Gempyre::Event& ev) {
             mousex = *GempyreUtils::parse<int>(ev.properties.at("clientX")) - rect.x;
             mousey = *GempyreUtils::parse<int>(ev.properties.at("clientY")) - rect.y;
             mousedown = true;
-            backupGraphics = graphics.clone();
+            selection.reset();
         }, {"clientX", "clientY"});
 
-        canvas.subscribe("mouseup", [&mousex, &mousey, &mousedown, &rect, &graphics, &backupGraphics,
+        canvas.subscribe("mouseup", [&mousex, &mousey, &mousedown, &rect, &graphics, &selection, &canvasMutex,
              &mandelbrot, &coordinateStack, &radius, &zooms, &updater, &canvas](const Gempyre::Event& ev) {
             const auto mx = *GempyreUtils::parse<int>(ev.properties.at("clientX")) - rect.x;
             const auto my = *GempyreUtils::parse<int>(ev.properties.at("clientY")) - rect.y;
             mousedown = false;
-            graphics = std::move(backupGraphics);
+            if(selection) { // shading covers the whole canvas
+                std::lock_guard<std::mutex> lock(canvasMutex);
+                canvas.draw(graphics);
+                selection.reset();
+            }
             const auto delta = std::max(mx - mousex, my - mousey);
             if(delta > 5) {
                 mandelbrot->setRect(mousex, mousey, delta, delta);
                 coordinateStack.push_back(mandelbrot->coords());
                 mandelbrot->update(updater);
             }
-            canvas.draw(graphics);
             radius.set_html(Mandelbrot::toString(mandelbrot->radius()));
             zooms.set_html(std::to_string(coordinateStack.size() - 1));
         }, {"clientX", "clientY"});
 
-        canvas.subscribe("mousemove", [&mousex, &mousey, &mousedown, &rect, &graphics, &backupGraphics, &blend, &canvas](const Gempyre::Event& ev) {
+        canvas.subscribe("mousemove", [&mousex, &mousey, &mousedown, &rect, &selection, &drawSelection](const Gempyre::Event& ev) {
             if(mousedown) {
-                const auto mx = *GempyreUtils::parse<int>(ev.properties.at("clientX")) - rect.x;
-                const auto my = *GempyreUtils::parse<int>(ev.properties.at("clientY")) - rect.y;
-                blend.draw_rect(Gempyre::Element::Rect{0, 0, rect.width, rect.height}, Gempyre::Bitmap::pix(0x73, 0x73, 0x73, 0x83));
-                blend.draw_rect(Gempyre::Element::Rect{mousex, mousey, mx - mousex, my - mousey}, Gempyre::Bitmap::pix(0,0,0,0));
-                graphics.merge(backupGraphics);
-                graphics.merge(blend);
-                canvas.draw(graphics);
+                const auto mx = std::clamp(*GempyreUtils::parse<int>(ev.properties.at("clientX")) - rect.x, 0, rect.width);
+                const auto my = std::clamp(*GempyreUtils::parse<int>(ev.properties.at("clientY")) - rect.y, 0, rect.height);
+                const Gempyre::Element::Rect selected{std::min(mousex, mx), std::min(mousey, my), std::abs(mx - mousex), std::abs(my - mousey)};
+                // only the union of the previous and the new selection changes
+                auto area = Gempyre::Element::Rect{0, 0, rect.width, rect.height};
+                if(selection) {
+                    const auto left = std::min(selection->x, selected.x);
+                    const auto top = std::min(selection->y, selected.y);
+                    const auto right = std::max(selection->x + selection->width, selected.x + selected.width);
+                    const auto bottom = std::max(selection->y + selection->height, selected.y + selected.height);
+                    area = Gempyre::Element::Rect{left, top, right - left, bottom - top};
+                }
+                if(area.width > 0 && area.height > 0)
+                    drawSelection(area, selected);
+                selection = selected;
             }
         }, {"clientX", "clientY"}, 200ms);
 
@@ -126,8 +175,9 @@ int main(int argc, char** argv) {
 
 
         graphics.create(rect.width, rect.height);
+        image.create(rect.width, rect.height);
         coordinateStack.push_back({-2, -2, 2, 2});
-        mandelbrot = std::make_unique<MandelbrotDraw>(graphics,
+        mandelbrot = std::make_unique<MandelbrotDraw>(image,
                 coordinateStack.back()[0],
                 coordinateStack.back()[1],
                 coordinateStack.back()[2],
@@ -135,8 +185,8 @@ int main(int argc, char** argv) {
                 ival);
 
         mandelbrot->setColors(cval);
+        mandelbrot->setRowsDrawn(rowsDrawn);
         mandelbrot->update(updater);
-        blend.create(rect.width, rect.height);
 
         radius.set_html(Mandelbrot::toString(mandelbrot->radius()));
         zooms.set_html(std::to_string(coordinateStack.size() - 1));
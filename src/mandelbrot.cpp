@@ -0,0 +1,249 @@
+#include "mandelbrot.h"
+
+#include <limits>
+#include <regex>
+
+namespace Mandelbrot {
+
+    Number sqrt(const Number& number) {
+        return
+#if defined(USE_APML)
+               ::sqrt(number);
+#elif defined (USE_MPFR)
+                number.sqrt();
+#else
+               std::sqrt(number);
+#endif
+    }
+
+
+    double toDouble(const Number& number) {
+        return
+#if defined(USE_APML)
+                static_cast<double>(number);
+#elif defined (USE_MPFR)
+                number.toDouble();
+#else
+                number;
+#endif
+    }
+
+
+    Number fromString(const std::string& str) {
+        return
+#if defined(USE_APML)
+                Number(str);
+#elif defined (USE_MPFR)
+                Number(str);
+#else
+                std::stod(str);
+#endif
+    }
+
+
+    bool isNumber(const std::string& str) {
+#if defined(USE_APML)
+        // APML reads what it can of malformed text instead of failing, hence the syntax check
+        static const std::regex decimal("[+-]?([0-9]+\\.?[0-9]*|\\.[0-9]+)([eE][+-]?[0-9]+)?");
+        return std::regex_match(str, decimal);
+#elif defined (USE_MPFR)
+        mpfr_t value;
+        mpfr_init2(value, Number::Precision);
+        const auto ok = mpfr_set_str(value, str.c_str(), 10, MPFR_RNDN) == 0;
+        mpfr_clear(value);
+        return ok;
+#else
+        try {
+            size_t end;
+            std::stod(str, &end);
+            return end == str.size();
+        } catch(...) {
+            return false;
+        }
+#endif
+    }
+
+
+    std::string toString(const Number& number) {
+        return
+#ifdef USE_APML
+                number.toString();
+#elif defined (USE_MPFR)
+                number.toString();
+#else
+                std::to_string(number);
+#endif
+
+    }
+
+
+    std::string engine(int limbs) {
+        if(limbs > 0)
+            return engine() + "+fixed" + std::to_string(limbs);
+        return
+#ifdef USE_APML
+                "apml-" + std::to_string(float_precision_ctrl.precision());
+#elif defined (USE_MPFR)
+                "mpfr-" + std::to_string(Number::Precision);
+#else
+                "double-" + std::to_string(std::numeric_limits<double>::digits);
+#endif
+    }
+
+
+    void tune() {
+#if defined(USE_APML) && defined(APML_LIMBS)
+        _float_precision_tune_umul();
+#endif
+    }
+
+
+#if defined(USE_APML)
+    ThreadSettings::ThreadSettings() : m_precision(float_precision_ctrl.precision()), m_mode(float_precision_ctrl.mode()) {}
+
+    void ThreadSettings::apply() const {
+        float_precision_ctrl.precision(static_cast<unsigned>(m_precision));
+        float_precision_ctrl.mode(m_mode);
+    }
+#else
+    ThreadSettings::ThreadSettings() {}
+
+    void ThreadSettings::apply() const {}
+#endif
+
+    float smoothFraction(double r2) {
+        const auto nu = std::log2(std::log(r2) / std::log(4.));
+        return static_cast<float>(std::min(std::max(1. - nu, 0.), 0.999999));
+    }
+
+    void Complex::sqrAdd(const Complex& c, Squares& s) {
+#if defined(USE_APML)
+        i *= r;
+        i += i;
+        i += c.i;
+        r = s.rr;
+        r -= s.ii;
+        r += c.r;
+        s.rr = r;
+        s.rr *= r;
+        s.ii = i;
+        s.ii *= i;
+        s.abs2 = s.rr;
+        s.abs2 += s.ii;
+#elif defined (USE_MPFR)
+        // same rounding as the operators, doubling is exact
+        mpfr_mul(i.m_value, r.m_value, i.m_value, MPFR_RNDU);
+        mpfr_mul_2ui(i.m_value, i.m_value, 1, MPFR_RNDU);
+        mpfr_add(i.m_value, i.m_value, c.i.m_value, MPFR_RNDU);
+        mpfr_sub(r.m_value, s.rr.m_value, s.ii.m_value, MPFR_RNDU);
+        mpfr_add(r.m_value, r.m_value, c.r.m_value, MPFR_RNDU);
+        mpfr_sqr(s.rr.m_value, r.m_value, MPFR_RNDU);
+        mpfr_sqr(s.ii.m_value, i.m_value, MPFR_RNDU);
+        mpfr_add(s.abs2.m_value, s.rr.m_value, s.ii.m_value, MPFR_RNDU);
+#else
+        i = 2. * r * i + c.i;
+        r = s.rr - s.ii + c.r;
+        s.rr = r * r;
+        s.ii = i * i;
+        s.abs2 = s.rr + s.ii;
+#endif
+    }
+
+    int calculate(const Complex& c, int iterations, float* fraction) {
+        const Number escape(4.); // not constructed for each iteration
+        Complex z(0, 0);
+        auto s = z.squares();
+        int n = 0;
+        while(s.abs2 <= escape && n < iterations) {
+            z.sqrAdd(c, s);
+            ++n;
+        }
+        if(fraction)
+            *fraction = n < iterations ? smoothFraction(toDouble(s.abs2)) : 0.f;
+        return n;
+    }
+
+    /// x truncated to a FixedPoint, the limbs are taken from x one at a time as the integer part
+    /// of the rest scaled by 2^32. The double estimate of a limb may be one too big.
+    template<int Limbs>
+    static FixedPoint<Limbs> toFixed(const Number& x) {
+        const Number zero(0);
+        const Number one(1);
+        const Number scale(4294967296.);
+        const auto negative = !(zero <= x);
+        auto v = negative ? zero - x : x;
+        FixedPoint<Limbs> out;
+        for(auto k = 0; k < Limbs; ++k) {
+            auto limb = std::floor(toDouble(v));
+            auto rest = v - Number(limb);
+            if(!(zero <= rest)) {
+                limb -= 1.;
+                rest = rest + one;
+            } else if(one <= rest) {
+                limb += 1.;
+                rest = rest - one;
+            }
+            out.limb(k) = static_cast<uint32_t>(limb);
+            v = rest * scale;
+        }
+        return negative ? -out : out;
+    }
+
+    template<int Limbs>
+    static int calculateFixed(const Complex& c, int iterations, float* fraction) {
+        using Fixed = FixedPoint<Limbs>;
+        const Fixed escape(4);
+        const auto cr = toFixed<Limbs>(c.r);
+        const auto ci = toFixed<Limbs>(c.i);
+        Fixed r, i, rr, ii, abs2;
+        int n = 0;
+        while(abs2 <= escape && n < iterations) {
+            i = r * i;
+            i += i;
+            i += ci;
+            r = rr;
+            r -= ii;
+            r += cr;
+            rr = r.sqr();
+            ii = i.sqr();
+            abs2 = rr;
+            abs2 += ii;
+            ++n;
+        }
+        if(fraction)
+            *fraction = n < iterations ? smoothFraction(abs2.toDouble()) : 0.f;
+        return n;
+    }
+
+    int fixedLimbs(const std::array<Number, 4>& view, const Number& realStep, const Number& imagStep) {
+#if defined(USE_APML) || defined(USE_MPFR)
+        constexpr auto GuardBits = 48; // for the error the iteration amplifies
+        constexpr auto MaxCoordinate = 16.; // |z|^2 of the step past the escape stays far below the 2^31 of the integer limb
+        for(const auto& v : view) {
+            const auto d = std::abs(toDouble(v));
+            if(!(d <= MaxCoordinate))
+                return 0;
+        }
+        const auto d = std::min(std::abs(toDouble(realStep)), std::abs(toDouble(imagStep)));
+        if(!(d > 0.) || !std::isfinite(d))
+            return 0;
+        const auto bits = static_cast<int>(std::ceil(-std::log2(d))) + GuardBits;
+        for(const auto limbs : {3, 4, 6, 8})
+            if(32 * (limbs - 1) >= bits)
+                return limbs;
+#else
+        (void) view; (void) realStep; (void) imagStep; // double is faster than any FixedPoint
+#endif
+        return 0;
+    }
+
+    int calculate(const Complex& c, int iterations, float* fraction, int limbs) {
+        switch(limbs) {
+        case 3: return calculateFixed<3>(c, iterations, fraction);
+        case 4: return calculateFixed<4>(c, iterations, fraction);
+        case 6: return calculateFixed<6>(c, iterations, fraction);
+        case 8: return calculateFixed<8>(c, iterations, fraction);
+        default: return calculate(c, iterations, fraction);
+        }
+    }
+}
@@ -6,11 +6,15 @@
 #include <fprecision.h>
 #elif defined(USE_MPFR)
 #include <mpfr.h>
-#else
-#include <cmath>
+#include "mpfrpool.h"
 #endif
 
+#include "fixedpoint.h"
+
+#include <array>
+#include <cmath>
 #include <string>
+#include <algorithm>
 
 namespace Mandelbrot {
 #if defined(USE_APML)
@@ -19,18 +23,31 @@ namespace Mandelbrot {
 class Number {
 public:
     ~Number() {if(m_set) mpfr_clear(m_value);}
-    Number() : m_set(true) {mpfr_init2 (m_value, 200);}
+    static constexpr mpfr_prec_t Precision = 200; // bits
+    Number() : m_set(true) {mpfr_init2 (m_value, Precision);}
     Number(double v) : Number() { mpfr_set_d (m_value, v, MPFR_RNDN);}
+    explicit Number(const std::string& v) : Number() { mpfr_set_str (m_value, v.c_str(), 10, MPFR_RNDN);}
     Number(Number&& other ) {mpfr_swap(other.m_value, m_value);
                             std::swap(m_set, other.m_set);
                             }
-    Number(const Number& other ) {mpfr_init_set(m_value, other.m_value, MPFR_RNDN);}
-    Number& operator=(Number&& other) {mpfr_swap(other.m_value, m_value); return *this;}
-    Number& operator=(const Number& other) {mpfr_init_set(m_value, other.m_value, MPFR_RNDN); return *this;}
+    Number(const Number& other ) : Number() {mpfr_set(m_value, other.m_value, MPFR_RNDN);} // mpfr_init_set would copy at the default 53 bits
+    Number& operator=(Number&& other) {mpfr_swap(other.m_value, m_value);
+                            std::swap(m_set, other.m_set);
+                            return *this;}
+    Number& operator=(const Number& other) {
+        if(m_set)
+            mpfr_set(m_value, other.m_value, MPFR_RNDN); // reuses the limbs
+        else {
+            mpfr_init2(m_value, Precision);
+            mpfr_set(m_value, other.m_value, MPFR_RNDN);
+        }
+        m_set = true;
+        return *this;}
     Number sqrt() const {
         Number out;
         mpfr_sqrt (out.m_value, m_value, MPFR_RNDN);
         return out;}
+    double toDouble() const {return mpfr_get_d(m_value, MPFR_RNDN);}
     std::string toString() const {
         mpfr_exp_t e;
         auto buf = mpfr_get_str(nullptr, &e, 10, 20, m_value, MPFR_RNDN);
@@ -46,6 +63,7 @@ public:
     friend Number operator-(const Number& a, const Number& b);
     friend Number operator/(const Number& a, const Number& b);
     friend bool operator<=(const Number& a, const Number& b);
+    friend class Complex;
 private:
     bool m_set = false;
     mpfr_t m_value;
@@ -61,56 +79,75 @@ inline bool operator<=(const Number& a, const Number& b) {return mpfr_lessequal_
     using Number = double;
 #endif
 
-    Number sqrt(const Number& number) {
-        return
+    Number sqrt(const Number& number);
+    double toDouble(const Number& number);
+    Number fromString(const std::string& str);
+    /// True if fromString parses all of str, e.g. a bound given by the user
+    bool isNumber(const std::string& str);
+    std::string toString(const Number& number);
+    /// Name and precision of the number backend, e.g. "mpfr-200", or "mpfr-200+fixed4" for pixels
+    /// iterated in FixedPoint of limbs
+    std::string engine(int limbs = 0);
+    /// Measure the arithmetic of the number backend on this CPU, i.e. the APML multiplication
+    /// crossovers. Call at startup before any workers run.
+    void tune();
+
+    /// Settings of the number backend that are per thread, i.e. the APML precision.
+    /// Taken in the thread that starts workers and applied in each of them.
+    class ThreadSettings {
+    public:
+        ThreadSettings();
+        void apply() const;
 #if defined(USE_APML)
-               ::sqrt(number);
-#elif defined (USE_MPFR)
-                number.sqrt();
-#else
-               std::sqrt(number);
+    private:
+        size_t m_precision;
+        round_mode m_mode;
 #endif
-    }
-
-
-    std::string toString(const Number& number) {
-        return
-#ifdef USE_APML
-                number.toString();
-#elif defined (USE_MPFR)
-                number.toString();
-#else
-                std::to_string(number);
-#endif
-
-    }
-
+    };
 
     class Complex {
     public:
+        /// r * r, i * i and their sum, kept between the steps of sqrAdd
+        struct Squares {
+            Number rr;
+            Number ii;
+            Number abs2;
+        };
         Complex(const Number& rr, const Number& ii) : r(rr), i(ii) {}
         Complex(Number&& rr, Number&& ii) : r(std::forward<Number>(rr)), i(std::forward<Number>(ii)) {}
         Complex(const Complex& other) = default;
         Complex(Complex&& other) = default;
         Complex& operator=(const Complex& other) = default;
+        Complex& operator=(Complex&& other) = default;
         Number abs2() const {return r * r + i * i;}
+        Squares squares() const {
+            Squares s{r * r, i * i, 0};
+            s.abs2 = s.rr + s.ii;
+            return s;
+        }
+        /// z = z * z + c in place with two squares and one multiply, as the squares of z
+        /// are known from its magnitude. They are updated to those of the result.
+        void sqrAdd(const Complex& c, Squares& s);
     public:
         Number r;
         Number i;
     };
 
-   Complex operator*(const Complex& a, const Complex& b) {return Complex(a.r * b.r - a.i * b.i, a.r * b.i + a.i * b.r);}
-   Complex operator+(const Complex& a, const Complex& b) {return Complex(a.r + b.r, a.i + b.i);}
+    inline Complex operator*(const Complex& a, const Complex& b) {return Complex(a.r * b.r - a.i * b.i, a.r * b.i + a.i * b.r);}
+    inline Complex operator+(const Complex& a, const Complex& b) {return Complex(a.r + b.r, a.i + b.i);}
 
-    int calculate(const Complex& c, int iterations) {
-        Complex z(0, 0);
-        int n = 0;
-        while(z.abs2() <= Number(4.) && n < iterations) {
-            z = z * z + c; //assign happens here! :-(
-            ++n;
-        }
-        return n;
-    }
+    /// Fractional part of the normalized iteration count, squared magnitude of
+    /// the escaped z is 4 < r2, the result is clamped to [0, 1).
+    float smoothFraction(double r2);
+
+    int calculate(const Complex& c, int iterations, float* fraction = nullptr);
+
+    /// Limbs of the FixedPoint numbers that resolve the pixels of the view {left, top, right, bottom}
+    /// the steps apart, 0 if only Number does or the view is too far out for the integer limb
+    int fixedLimbs(const std::array<Number, 4>& view, const Number& realStep, const Number& imagStep);
+
+    /// As above, iterated in FixedPoint<limbs> if there is such a type, else in Number
+    int calculate(const Complex& c, int iterations, float* fraction, int limbs);
 }
 
 
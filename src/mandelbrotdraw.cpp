@@ -0,0 +1,227 @@
+#include "mandelbrotdraw.h"
+
+void MandelbrotDraw::update(std::function<void (int, int)> onComplete) {
+    m_results.clear();
+    m_updates = 0;
+    m_cancel = false;
+    const auto threads = m_threads;
+    const auto span = symmetricSpan();
+    m_frame.resize(m_g.width(), m_g.height());
+    m_computed = 0;
+    m_guessed = 0;
+    m_corrected = 0;
+    m_reused = 0;
+    m_useSeed = m_seed.width() == m_frame.width() && m_seed.height() == m_frame.height();
+    const Mandelbrot::ThreadSettings settings;
+    const auto updater = [this, onComplete, threads, span, settings](int hstart, int hend) { //yes it is needed for MSVC :-(
+        settings.apply();
+        if(m_strategy == Strategy::Guessing)
+            guess(hstart, hend, span);
+        else
+            scan(hstart, hend, span);
+        if(m_cancel)
+            return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        drawBand(hstart, hend, span);
+        onComplete(++m_updates, threads + 1);
+    };
+    const auto lines = span.end - span.begin;
+    int linesInThread = lines / threads;
+    int lastLinesInThread = lines % threads;
+    for(auto n = 0; n < threads; n++)
+        m_results.push_back(std::async(std::launch::async, updater, span.begin + n * linesInThread, span.begin + (n + 1) * linesInThread));
+    m_results.push_back(std::async(std::launch::async, updater, span.end - lastLinesInThread , span.end));
+    onComplete(0, threads);
+}
+
+MandelbrotDraw::Span MandelbrotDraw::symmetricSpan() const {
+    const auto height = m_g.height();
+    const auto top = Mandelbrot::toDouble(m_top);
+    const auto bottom = Mandelbrot::toDouble(m_bottom);
+    if(!((top < 0. && bottom > 0.) || (top > 0. && bottom < 0.)))
+        return {0, height, -1};
+    const auto axis2 = 2. * height * top / (top - bottom);
+    const auto rounded = std::round(axis2);
+    if(std::abs(axis2 - rounded) > SymmetryTolerance)
+        return {0, height, -1};
+    const auto a2 = static_cast<int>(rounded);
+    if(a2 <= 0 || a2 >= 2 * height) // rounded onto an edge, there are no rows to mirror
+        return {0, height, -1};
+    return a2 < height ? Span{(a2 + 1) / 2, height, a2} : Span{0, a2 / 2 + 1, a2};
+}
+
+void MandelbrotDraw::scan(int hstart, int hend, const Span& span) {
+    for(auto y = hstart; y < hend; y++) {
+        if(m_cancel)
+            return;
+        auto its = m_frame.iterations(y);
+        auto fractions = m_frame.fractions(y);
+        auto reused = 0;
+        for(auto x = 0; x < m_frame.width(); x++) {
+            if(fromSeed(x, y, its[x], fractions[x])) {
+                ++reused;
+                continue;
+            }
+            its[x] = iterate(x, y, fractions[x]);
+            yield();
+        }
+        std::fill_n(m_frame.flags(y), m_frame.width(), Mandelbrot::FrameBuffer::Computed);
+        m_computed += m_frame.width() - reused;
+        m_reused += reused;
+        const auto mirror = span.mirror(y, m_frame.height());
+        if(mirror >= 0)
+            m_frame.mirror(y, mirror);
+         pause();
+    }
+}
+
+void MandelbrotDraw::guess(int hstart, int hend, const Span& span) {
+    const auto width = m_frame.width();
+    const auto rows = std::min(hend + 1, m_frame.height()) - hstart; // the row below the band bounds the last guesses
+    if(hend <= hstart)
+        return;
+    enum State : unsigned char {Unknown, Computed, Guessed, Corrected};
+    std::vector<int> its(static_cast<size_t>(width * rows));
+    std::vector<float> fractions(its.size());
+    std::vector<State> states(its.size(), Unknown);
+    const auto index = [width](int x, int r) {return static_cast<size_t>(r * width + x);};
+    const auto isGrid = [](int p, int count) {return (p & 0x1) == 0 || p == count - 1;};
+    auto computed = 0;
+    auto corrected = 0;
+    auto guessed = 0;
+    auto reused = 0;
+    const auto compute = [&](int x, int r) {
+        states[index(x, r)] = Computed;
+        const auto counted = hstart + r < hend; // the row below belongs to the next band
+        if(fromSeed(x, hstart + r, its[index(x, r)], fractions[index(x, r)])) {
+            reused += counted;
+            return;
+        }
+        computed += counted;
+        its[index(x, r)] = iterate(x, hstart + r, fractions[index(x, r)]);
+        yield();
+    };
+
+    for(auto r = 0; r < rows; r += 2) {
+        if(m_cancel)
+            return;
+        for(auto x = 0; x < width; x++)
+            if(isGrid(x, width))
+                compute(x, r);
+        if(r + 2 >= rows && r != rows - 1)
+            r = rows - 3; // the last row is always calculated
+        pause();
+    }
+
+    for(auto r = 0; r < rows; r++) {
+        if(m_cancel)
+            return;
+        for(auto x = 0; x < width; x++) {
+            if(states[index(x, r)] != Unknown)
+                continue;
+            const auto x0 = isGrid(x, width) ? x : x - 1;
+            const auto x1 = isGrid(x, width) ? x : x + 1;
+            const auto r0 = isGrid(r, rows) ? r : r - 1;
+            const auto r1 = isGrid(r, rows) ? r : r + 1;
+            const auto it = its[index(x0, r0)];
+            if(it == its[index(x1, r0)] && it == its[index(x0, r1)] && it == its[index(x1, r1)]) {
+                its[index(x, r)] = it;
+                fractions[index(x, r)] = fractions[index(x0, r0)];
+                states[index(x, r)] = Guessed;
+            } else
+                compute(x, r);
+        }
+    }
+
+    std::vector<std::pair<int, int>> suspects;
+    const auto neighbours = [&](int x, int r, const auto& f) {
+        if(x > 0) f(x - 1, r);
+        if(x < width - 1) f(x + 1, r);
+        if(r > 0) f(x, r - 1);
+        if(r < rows - 1) f(x, r + 1);
+    };
+    for(auto r = 0; r < rows; r++)
+        for(auto x = 0; x < width; x++)
+            if(states[index(x, r)] == Guessed) {
+                bool edge = false;
+                neighbours(x, r, [&](int nx, int nr) {edge |= its[index(nx, nr)] != its[index(x, r)];});
+                if(edge)
+                    suspects.emplace_back(x, r);
+            }
+    while(!suspects.empty()) {
+        if(m_cancel)
+            return;
+        const auto [x, r] = suspects.back();
+        suspects.pop_back();
+        if(states[index(x, r)] != Guessed)
+            continue;
+        const auto guess = its[index(x, r)];
+        compute(x, r);
+        if(its[index(x, r)] != guess) {
+            ++corrected;
+            states[index(x, r)] = Corrected;
+            neighbours(x, r, [&](int nx, int nr) {
+                if(states[index(nx, nr)] == Guessed)
+                    suspects.emplace_back(nx, nr);
+            });
+        }
+    }
+
+    const auto bandSize = static_cast<size_t>(width * (hend - hstart));
+    std::copy_n(its.begin(), bandSize, m_frame.iterations(hstart));
+    std::copy_n(fractions.begin(), bandSize, m_frame.fractions(hstart));
+    const auto flags = m_frame.flags(hstart);
+    for(auto i = 0U; i < bandSize; i++) {
+        switch(states[i]) {
+        case Guessed: flags[i] = Mandelbrot::FrameBuffer::Guessed; ++guessed; break;
+        case Corrected: flags[i] = Mandelbrot::FrameBuffer::Corrected; break;
+        default: flags[i] = Mandelbrot::FrameBuffer::Computed;
+        }
+    }
+    for(auto y = hstart; y < hend; y++) {
+        const auto mirror = span.mirror(y, m_frame.height());
+        if(mirror >= 0)
+            m_frame.mirror(y, mirror);
+    }
+    m_computed += computed;
+    m_guessed += guessed;
+    m_corrected += corrected;
+    m_reused += reused;
+}
+
+void MandelbrotDraw::draw() {
+    draw(0, m_frame.height());
+    if(m_rowsDrawn)
+        m_rowsDrawn(0, m_frame.height());
+}
+
+void MandelbrotDraw::draw(int begin, int end) {
+    for(auto y = begin; y < end; y++)
+        m_palette.apply(m_frame.iterations(y), m_g.row(y), m_frame.width());
+}
+
+void MandelbrotDraw::drawBand(int hstart, int hend, const Span& span) {
+    if(hend <= hstart)
+        return;
+    draw(hstart, hend);
+    if(m_rowsDrawn)
+        m_rowsDrawn(hstart, hend - hstart);
+    if(span.axis2 < 0)
+        return;
+    // mirrors of a band are a band too, rows on the axis are their own
+    const auto begin = std::max(0, span.axis2 - hend + 1);
+    const auto end = std::min(m_frame.height(), span.axis2 - hstart + 1);
+    if(begin >= end)
+        return;
+    draw(begin, end);
+    if(m_rowsDrawn)
+        m_rowsDrawn(begin, end - begin);
+}
+
+std::vector<Mandelbrot::Number> MandelbrotDraw::axis(const Mandelbrot::Number& start, const Mandelbrot::Number& step, int count) {
+    std::vector<Mandelbrot::Number> out;
+    out.reserve(static_cast<size_t>(count));
+    for(auto i = 0; i < count; ++i)
+        out.push_back(start + step * Mandelbrot::Number(i));
+    return out;
+}
@@ -2,31 +2,63 @@
 #define MANDELBROTDRAW_H
 
 #include "mandelbrot.h"
-#include <gempyre_graphics.h>
-#include <gempyre_utils.h>
+#include "framebuffer.h"
+#include "image.h"
+#include "palette.h"
 
 #include <array>
 #include <cmath>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <atomic>
+#include <algorithm>
 
 #include <future>
 #include <mutex>
+#include <thread>
 
 using namespace std::chrono_literals;
 
 class MandelbrotDraw {
 public:
-    using Color = Gempyre::Color::type;
-    MandelbrotDraw(Gempyre::Bitmap& g, const Mandelbrot::Number& left, const Mandelbrot::Number& top, const Mandelbrot::Number& right, const Mandelbrot::Number& bottom, int iterations) :
-        m_g(g), m_height(static_cast<Mandelbrot::Number>(g.height())), m_left(left), m_right(right), m_top(top), m_bottom(bottom), m_iterations(iterations) {
+    using Color = Mandelbrot::Color::type;
+    /// Rows [y, y + rows) of the image are drawn
+    using RowsDrawn = std::function<void (int y, int rows)>;
+    static constexpr double SymmetryTolerance = 1e-3; // in pixels
+    enum class Strategy {Exhaustive, Guessing};
+    struct GuessStats {
+        int computed;
+        int guessed;
+        int corrected;
+        int reused;     // taken from the seed
+        double guessedRatio() const {return computed + guessed > 0 ? static_cast<double>(guessed) / (computed + guessed) : 0.;}
+    };
+    MandelbrotDraw(Mandelbrot::Image& g, const Mandelbrot::Number& left, const Mandelbrot::Number& top, const Mandelbrot::Number& right, const Mandelbrot::Number& bottom, int iterations) :
+        MandelbrotDraw(g, left, top, right, bottom, iterations,
+                       (right - left) / Mandelbrot::Number(g.width()), (bottom - top) / Mandelbrot::Number(g.height())) {}
+
+    /// As above with the steps between pixels known, e.g. shared by the tiles of a pyramid level
+    MandelbrotDraw(Mandelbrot::Image& g, const Mandelbrot::Number& left, const Mandelbrot::Number& top, const Mandelbrot::Number& right, const Mandelbrot::Number& bottom, int iterations,
+                   const Mandelbrot::Number& realStep, const Mandelbrot::Number& imagStep) :
+        m_g(g), m_width(static_cast<Mandelbrot::Number>(g.width())), m_height(static_cast<Mandelbrot::Number>(g.height())), m_left(left), m_right(right), m_top(top), m_bottom(bottom), m_iterations(iterations) {
         makeLut();
+        makeAxes(realStep, imagStep);
+    }
+
+    ~MandelbrotDraw() {
+        m_cancel = true;
+        wait();
     }
 
-    inline Mandelbrot::Number real(const Mandelbrot::Number& r) const {return coord(m_left, m_right, r);}
-    inline Mandelbrot::Number img(const Mandelbrot::Number& i) const {return coord(m_top, m_bottom, i);}
+    inline Mandelbrot::Number real(const Mandelbrot::Number& r) const {return m_left + m_realStep * r;}
+    inline Mandelbrot::Number img(const Mandelbrot::Number& i) const {return m_top + m_imagStep * i;}
 
     void set(const Mandelbrot::Number& left, const Mandelbrot::Number& top, const Mandelbrot::Number& right, const Mandelbrot::Number& bottom) {
         cancel();
         m_left = left; m_right = right; m_top = top; m_bottom = bottom;
+        m_seed = Mandelbrot::FrameBuffer();
+        makeAxes();
     }
 
     void setRect(int x, int y, int width, int height) {
@@ -53,42 +85,83 @@ public:
         makeLut();
     }
 
+    /// Iteration data of the latest update
+    const Mandelbrot::FrameBuffer& frame() const {
+        return m_frame;
+    }
+
     std::array<Mandelbrot::Number, 4> coords() const {
         return {m_left, m_top, m_right, m_bottom};
     }
 
-    void update(std::function<void (int, int)> onComplete) {
+    void update(std::function<void (int, int)> onComplete);
+
+    /// Called from the workers as bands are finished, so that only the changed rows need to be shown
+    void setRowsDrawn(RowsDrawn rowsDrawn) {
+        cancel();
+        m_rowsDrawn = rowsDrawn;
+    }
+
+    /// Draw iteration data calculated earlier instead of updating, false if it is not of the image size
+    bool show(Mandelbrot::FrameBuffer&& frame) {
+        if(frame.width() != m_g.width() || frame.height() != m_g.height())
+            return false;
+        cancel();
+        wait();
         m_results.clear();
-        m_updates = 0;
-        m_cancel = false;
-        const auto threads = 11;
-        const auto updater = [this, onComplete, threads](int hstart, int hend) { //yes it is needed for MSVC :-(
-            for(auto y = hstart; y < hend; y++) {
-                if(m_cancel)
-                    return;
-                for(auto x = 0; x < m_g.width(); x++) {
-                    const Mandelbrot::Complex c (real(static_cast<double>(x)),
-                                                 img(static_cast<double>(y)));
-                    const auto it = Mandelbrot::calculate(c, m_iterations);
-                    if(it < m_iterations)
-                        m_g.set_pixel(x, y, m_colorlut[static_cast<unsigned>(it)]);
-                    else
-                        m_g.set_pixel(x, y, Gempyre::Color::Black);
-                    std::this_thread::yield(); //let the other thread run
-                }
-                 std::this_thread::sleep_for(100ms); //make others happen
-            }
-            ++m_updates;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            onComplete(m_updates, threads + 1);
-        };
-        int linesInThread = m_g.height() / threads;
-        int lastLinesInThread = m_g.height() % threads;
-        for(auto n = 0; n < threads; n++)
-            m_results.push_back(std::async(std::launch::async, updater, n * linesInThread, (n + 1) * linesInThread));
-        m_results.push_back(std::async(std::launch::async, updater, m_g.height() - lastLinesInThread , m_g.height()));
-        onComplete(0, threads);
+        m_frame = std::move(frame);
+        m_computed = 0;
+        m_guessed = 0;
+        m_corrected = 0;
+        m_reused = 0;
+        draw();
+        return true;
     }
+
+    /// Block until the latest update is complete or cancelled
+    void wait() {
+        std::for_each(m_results.begin(), m_results.end(), [](auto& f){f.wait();});
+    }
+
+    void setStrategy(Strategy strategy) {
+        cancel();
+        m_strategy = strategy;
+    }
+
+    Strategy strategy() const {
+        return m_strategy;
+    }
+
+    /// Number engine the pixels of the view are iterated in
+    std::string engine() const {
+        return Mandelbrot::engine(m_limbs);
+    }
+
+    /// Pixel counts of the latest update, guessed pixels are never calculated
+    /// and corrected ones were guessed wrong and calculated when verified.
+    GuessStats guessStats() const {
+        return {m_computed, m_guessed, m_corrected, m_reused};
+    }
+
+    /// Pixels already known for the next update, e.g. from the previous frame of a zoom.
+    /// Pixels with a flag set are copied from the seed instead of calculated.
+    void setSeed(Mandelbrot::FrameBuffer&& seed) {
+        cancel();
+        m_seed = std::move(seed);
+    }
+
+    /// Workers give way to others after each row, set to zero when there is no UI to keep responsive
+    void setPause(std::chrono::milliseconds pause) {
+        cancel();
+        m_pause = pause;
+    }
+
+    /// Bands calculated in parallel, one when the caller already runs many renders at once
+    void setThreads(int threads) {
+        cancel();
+        m_threads = std::max(1, threads);
+    }
+
     void blend(Color colorStart, Color colorEnd) {
         cancel();
         m_colorStart = colorStart;
@@ -96,47 +169,80 @@ public:
         makeLut();
     }
 private:
-    inline Mandelbrot::Number coord(const Mandelbrot::Number& start, const Mandelbrot::Number& end, const Mandelbrot::Number& screenPos) const {
-        return start + (screenPos / m_height) * (end - start);
+    /// Rows [begin, end) are calculated, the rest of the rows are mirror images of them.
+    struct Span {
+        int begin;
+        int end;
+        int axis2; // twice the row of the real axis, -1 if there is no symmetry
+        int mirror(int y, int height) const {
+            const auto m = axis2 - y;
+            return (axis2 >= 0 && m != y && m >= 0 && m < height) ? m : -1;
+        }
+    };
+
+    /// The set is symmetric about the real axis, if the view crosses it and pixel rows
+    /// are aligned about it, only the larger half is calculated.
+    Span symmetricSpan() const;
+
+    int iterate(int x, int y, float& fraction) {
+        const Mandelbrot::Complex c (m_realAxis[static_cast<unsigned>(x)],
+                                     m_imagAxis[static_cast<unsigned>(y)]);
+        return Mandelbrot::calculate(c, m_iterations, &fraction, m_limbs);
+    }
+
+    bool fromSeed(int x, int y, int& iterations, float& fraction) const {
+        if(!m_useSeed || m_seed.flag(x, y) == Mandelbrot::FrameBuffer::None)
+            return false;
+        iterations = m_seed.iteration(x, y);
+        fraction = m_seed.fraction(x, y);
+        return true;
+    }
+
+    /// Calculate every pixel
+    void scan(int hstart, int hend, const Span& span);
+
+    /// Solid guessing: calculate every second pixel of every second row, and guess the
+    /// pixels between them if all the surrounding calculated pixels are equal. As a guess is
+    /// wrong only if some detail fits between calculated pixels, guesses next to a different
+    /// value are verified, and a failed guess puts its neighbours under verification too.
+    void guess(int hstart, int hend, const Span& span);
+
+    void yield() const {
+        if(m_pause > 0ms)
+            std::this_thread::yield(); //let the other thread run
+    }
+
+    void pause() const {
+        if(m_pause > 0ms)
+            std::this_thread::sleep_for(m_pause); //make others happen
     }
+
+    /// Convert the frame to colors, the image is not written anywhere else
+    void draw();
+    void draw(int begin, int end);
+
+    /// Draw a finished band and the rows mirrored from it
+    void drawBand(int hstart, int hend, const Span& span);
+
+    /// Coordinates of each pixel column or row
+    static std::vector<Mandelbrot::Number> axis(const Mandelbrot::Number& start, const Mandelbrot::Number& step, int count);
+
+    /// The steps between pixels are divided once per frame, so that coordinates only multiply.
+    /// They also pick the FixedPoint size the pixels are iterated in.
+    void makeAxes() {
+        makeAxes((m_right - m_left) / m_width, (m_bottom - m_top) / m_height);
+    }
+
+    void makeAxes(const Mandelbrot::Number& realStep, const Mandelbrot::Number& imagStep) {
+        m_realStep = realStep;
+        m_imagStep = imagStep;
+        m_realAxis = axis(m_left, m_realStep, m_g.width());
+        m_imagAxis = axis(m_top, m_imagStep, m_g.height());
+        m_limbs = Mandelbrot::fixedLimbs(coords(), m_realStep, m_imagStep);
+    }
+
     void makeLut() {
-        m_colorlut.resize(static_cast<size_t>(m_iterations));
-        const auto r0 = static_cast<double>(Gempyre::Color::r(m_colorStart));
-        const auto g0 = static_cast<double>(Gempyre::Color::g(m_colorStart));
-        const auto b0 = static_cast<double>(Gempyre::Color::b(m_colorStart));
-        const auto r1 = static_cast<double>(Gempyre::Color::r(m_colorEnd));
-        const auto g1 = static_cast<double>(Gempyre::Color::g(m_colorEnd));
-        const auto b1 = static_cast<double>(Gempyre::Color::b(m_colorEnd));
-        auto r = r0;
-        auto g = g0;
-        auto b = b0;
-        auto lutpos = 0U;
-
-        const auto lutcycle = static_cast<double>(m_iterations) / static_cast<double>(m_colorCycles);
-        int cycle = 0;
-        for(; cycle < m_colorCycles; ++cycle) {
-            const bool odd = cycle & 0x1;
-            const auto dr = (odd ? (r0 - r1) : (r1 - r0)) / lutcycle;
-            const auto dg = (odd ? (g0 - g1) : (g1 - g0)) / lutcycle;
-            const auto db = (odd ? (b0 - b1) : (b1 - b0)) / lutcycle;
-            for(int i= 0; i < static_cast<int>(lutcycle); ++i) {
-                m_colorlut[lutpos] = Gempyre::Bitmap::pix(static_cast<unsigned>(r), static_cast<unsigned>(g), static_cast<unsigned>(b));
-                r += dr;
-                g += dg;
-                b += db;
-                ++lutpos;
-            }
-        }
-        const bool odd = cycle & 0x1;
-        const auto dr = (odd ? (r0 - r1) : (r1 - r0)) / lutcycle;
-        const auto dg = (odd ? (g0 - g1) : (g1 - g0)) / lutcycle;
-        const auto db = (odd ? (b0 - b1) : (b1 - b0)) / lutcycle;
-        for(; lutpos < static_cast<unsigned>(m_iterations); ++lutpos) {
-            m_colorlut[lutpos] = Gempyre::Bitmap::pix(static_cast<unsigned>(r), static_cast<unsigned>(g), static_cast<unsigned>(b));
-            r += dr;
-            g += dg;
-            b += db;
-        }
+        m_palette = Mandelbrot::Palette(m_iterations, m_colorCycles, m_colorStart, m_colorEnd);
     }
 
     void cancel() {
@@ -144,17 +250,32 @@ private:
         std::for_each(m_results.begin(), m_results.end(), [](auto& f){f.wait_for(5s);});
     }
 
-    Gempyre::Bitmap& m_g;
+    Mandelbrot::Image& m_g;
+    const Mandelbrot::Number m_width;
     const Mandelbrot::Number m_height;
     Mandelbrot::Number m_left, m_right, m_top, m_bottom;
+    Mandelbrot::Number m_realStep, m_imagStep;
+    std::vector<Mandelbrot::Number> m_realAxis, m_imagAxis;
+    int m_limbs = 0; // of the FixedPoint pixels are iterated in, 0 for Number
     int m_iterations;
-    Color m_colorStart = Gempyre::Color::Red;
-    Color m_colorEnd = Gempyre::Color::Blue;
+    Color m_colorStart = Mandelbrot::Color::Red;
+    Color m_colorEnd = Mandelbrot::Color::Blue;
     int m_colorCycles = 1;
-    std::vector<Color> m_colorlut;
+    Mandelbrot::Palette m_palette;
+    Mandelbrot::FrameBuffer m_frame;
+    Mandelbrot::FrameBuffer m_seed;
+    bool m_useSeed = false;
     std::vector<std::future<void>> m_results;
+    RowsDrawn m_rowsDrawn;
     std::atomic_bool m_cancel = false;
     std::atomic_int m_updates = 0;
+    Strategy m_strategy = Strategy::Exhaustive;
+    std::chrono::milliseconds m_pause = 100ms;
+    int m_threads = 11;
+    std::atomic_int m_computed = 0;
+    std::atomic_int m_guessed = 0;
+    std::atomic_int m_corrected = 0;
+    std::atomic_int m_reused = 0;
     std::mutex m_mutex;
 };
 
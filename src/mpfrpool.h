@@ -0,0 +1,255 @@
+#ifndef MPFRPOOL_H
+#define MPFRPOOL_H
+
+#if defined(USE_MPFR)
+
+#include <gmp.h>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+/// Limb storage of MPFR numbers from per thread free lists, installed into GMP
+/// with mp_set_memory_functions. A thread takes blocks from the shared depot only
+/// when its own list runs dry and gives them back when it exits, therefore after the
+/// first frame the iteration loop neither calls malloc nor touches a shared lock.
+namespace Mandelbrot::MpfrPool {
+
+    struct Stats {
+        unsigned long long allocations;         // requests served since reset
+        unsigned long long systemAllocations;   // of them the ones that needed malloc
+        size_t bytes;                           // held from the system
+        size_t peakBytes;                       // max held since reset
+    };
+
+    constexpr size_t Granularity = 16;
+    constexpr size_t Classes = 64;              // larger blocks are passed to malloc
+    constexpr size_t MaxPooled = Granularity * Classes;
+    constexpr unsigned Batch = 8;                // blocks taken from the depot at once
+
+    inline size_t sizeClass(size_t size) {return (std::max<size_t>(size, 1) + Granularity - 1) / Granularity - 1;}
+
+    struct Block {
+        Block* next;
+    };
+
+    class Depot {
+    public:
+        void push(size_t cls, Block* head, Block* tail) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            tail->next = m_lists[cls];
+            m_lists[cls] = head;
+        }
+        Block* pop(size_t cls) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto head = m_lists[cls];
+            if(!head)
+                return nullptr;
+            auto tail = head;
+            for(auto n = 1U; n < Batch && tail->next; ++n)
+                tail = tail->next;
+            m_lists[cls] = tail->next;
+            tail->next = nullptr;
+            return head;
+        }
+        void add(const Stats& s) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_retired.allocations += s.allocations;
+            m_retired.systemAllocations += s.systemAllocations;
+        }
+        Stats retired() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_retired;
+        }
+        void reset() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_retired = {};
+        }
+    private:
+        std::mutex m_mutex;
+        std::array<Block*, Classes> m_lists = {};
+        Stats m_retired = {};
+    };
+
+    inline Depot& depot() {
+        static Depot d;
+        return d;
+    }
+
+    inline std::atomic<size_t>& bytes() {static std::atomic<size_t> b{0}; return b;}
+    inline std::atomic<size_t>& peakBytes() {static std::atomic<size_t> b{0}; return b;}
+    inline std::atomic<unsigned>& generation() {static std::atomic<unsigned> g{0}; return g;}
+
+    inline void* system(size_t size) {
+        const auto held = bytes() += size;
+        auto peak = peakBytes().load(std::memory_order_relaxed);
+        while(held > peak && !peakBytes().compare_exchange_weak(peak, held, std::memory_order_relaxed));
+        return std::malloc(size);
+    }
+
+    /// Pooled blocks freed without an arena go to the depot
+    inline void freeShared(void* ptr, size_t size) {
+        if(size > MaxPooled) {
+            bytes() -= size;
+            std::free(ptr);
+            return;
+        }
+        auto block = static_cast<Block*>(ptr);
+        block->next = nullptr;
+        depot().push(sizeClass(size), block, block);
+    }
+
+    /// Set when the arena of the thread is destroyed at its exit, GMP may still call
+    /// the hooks afterwards, e.g. from the destructor of another thread_local
+    inline bool& released() {
+        thread_local bool r = false;
+        return r;
+    }
+
+    class Arena;
+
+    class Registry {
+    public:
+        void add(Arena* a) {std::lock_guard<std::mutex> lock(m_mutex); m_arenas.push_back(a);}
+        void remove(Arena* a) {std::lock_guard<std::mutex> lock(m_mutex); m_arenas.erase(std::find(m_arenas.begin(), m_arenas.end(), a));}
+        template <class F> void forEach(F f) {std::lock_guard<std::mutex> lock(m_mutex); std::for_each(m_arenas.begin(), m_arenas.end(), f);}
+    private:
+        std::mutex m_mutex;
+        std::vector<Arena*> m_arenas;
+    };
+
+    inline Registry& registry() {
+        static Registry r;
+        return r;
+    }
+
+    class Arena {
+    public:
+        Arena() {registry().add(this);}
+        ~Arena() {
+            released() = true;
+            for(auto cls = 0U; cls < Classes; ++cls) {
+                if(!m_lists[cls])
+                    continue;
+                auto tail = m_lists[cls];
+                while(tail->next)
+                    tail = tail->next;
+                depot().push(cls, m_lists[cls], tail);
+            }
+            depot().add(local());
+            registry().remove(this);
+        }
+
+        void* allocate(size_t size) {
+            sync();
+            m_allocations.fetch_add(1, std::memory_order_relaxed);
+            if(size > MaxPooled) {
+                m_systemAllocations.fetch_add(1, std::memory_order_relaxed);
+                return system(size);
+            }
+            const auto cls = sizeClass(size);
+            if(!m_lists[cls])
+                m_lists[cls] = depot().pop(cls);
+            if(auto block = m_lists[cls]) {
+                m_lists[cls] = block->next;
+                return block;
+            }
+            m_systemAllocations.fetch_add(1, std::memory_order_relaxed);
+            return system((cls + 1) * Granularity);
+        }
+
+        void free(void* ptr, size_t size) {
+            if(size > MaxPooled) {
+                freeShared(ptr, size);
+                return;
+            }
+            const auto cls = sizeClass(size);
+            auto block = static_cast<Block*>(ptr);
+            block->next = m_lists[cls];
+            m_lists[cls] = block;
+        }
+
+        /// Counts of the current statistics period
+        Stats local() const {
+            if(m_generation.load(std::memory_order_relaxed) != generation().load(std::memory_order_relaxed))
+                return {};
+            return {m_allocations.load(std::memory_order_relaxed), m_systemAllocations.load(std::memory_order_relaxed), 0, 0};
+        }
+
+    private:
+        // Counters are reset lazily by the owning thread, so they are never written by others
+        void sync() {
+            const auto g = generation().load(std::memory_order_relaxed);
+            if(g != m_generation.load(std::memory_order_relaxed)) {
+                m_allocations.store(0, std::memory_order_relaxed);
+                m_systemAllocations.store(0, std::memory_order_relaxed);
+                m_generation.store(g, std::memory_order_relaxed);
+            }
+        }
+    private:
+        std::array<Block*, Classes> m_lists = {};
+        std::atomic<unsigned long long> m_allocations{0};
+        std::atomic<unsigned long long> m_systemAllocations{0};
+        std::atomic<unsigned> m_generation{generation().load()};
+    };
+
+    inline Arena& arena() {
+        thread_local Arena a;
+        return a;
+    }
+
+    inline void* allocate(size_t size) {
+        if(released()) // of the pooled sizes, so that other arenas can take them
+            return system(size > MaxPooled ? size : (sizeClass(size) + 1) * Granularity);
+        return arena().allocate(size);
+    }
+
+    inline void release(void* ptr, size_t size) {
+        if(released())
+            freeShared(ptr, size);
+        else
+            arena().free(ptr, size);
+    }
+
+    inline void* reallocate(void* ptr, size_t oldSize, size_t newSize) {
+        if(oldSize <= MaxPooled && newSize <= MaxPooled && sizeClass(oldSize) == sizeClass(newSize))
+            return ptr;
+        auto out = allocate(newSize);
+        std::memcpy(out, ptr, std::min(oldSize, newSize));
+        release(ptr, oldSize);
+        return out;
+    }
+
+    /// Must be called before any GMP or MPFR memory is allocated
+    inline void install() {
+        mp_set_memory_functions(allocate, reallocate, release);
+    }
+
+    /// Start a new statistics period, e.g. a frame
+    inline void resetStats() {
+        ++generation();
+        depot().reset();
+        peakBytes() = bytes().load();
+    }
+
+    /// Statistics since the latest reset
+    inline Stats stats() {
+        auto s = depot().retired();
+        registry().forEach([&s](const Arena* a) {
+            const auto l = a->local();
+            s.allocations += l.allocations;
+            s.systemAllocations += l.systemAllocations;
+        });
+        s.bytes = bytes();
+        s.peakBytes = peakBytes();
+        return s;
+    }
+}
+
+#endif // USE_MPFR
+
+#endif // MPFRPOOL_H
@@ -0,0 +1,43 @@
+#include "palette.h"
+
+using namespace Mandelbrot;
+
+Palette::Palette(int iterations, int cycles, Color::type from, Color::type to) {
+    m_lut.resize(static_cast<size_t>(iterations));
+    const auto r0 = static_cast<double>(Color::r(from));
+    const auto g0 = static_cast<double>(Color::g(from));
+    const auto b0 = static_cast<double>(Color::b(from));
+    const auto r1 = static_cast<double>(Color::r(to));
+    const auto g1 = static_cast<double>(Color::g(to));
+    const auto b1 = static_cast<double>(Color::b(to));
+    auto r = r0;
+    auto g = g0;
+    auto b = b0;
+    auto lutpos = 0U;
+
+    const auto lutcycle = static_cast<double>(iterations) / static_cast<double>(cycles);
+    int cycle = 0;
+    for(; cycle < cycles; ++cycle) {
+        const bool odd = cycle & 0x1;
+        const auto dr = (odd ? (r0 - r1) : (r1 - r0)) / lutcycle;
+        const auto dg = (odd ? (g0 - g1) : (g1 - g0)) / lutcycle;
+        const auto db = (odd ? (b0 - b1) : (b1 - b0)) / lutcycle;
+        for(int i= 0; i < static_cast<int>(lutcycle); ++i) {
+            m_lut[lutpos] = Color::rgba(static_cast<unsigned>(r), static_cast<unsigned>(g), static_cast<unsigned>(b));
+            r += dr;
+            g += dg;
+            b += db;
+            ++lutpos;
+        }
+    }
+    const bool odd = cycle & 0x1;
+    const auto dr = (odd ? (r0 - r1) : (r1 - r0)) / lutcycle;
+    const auto dg = (odd ? (g0 - g1) : (g1 - g0)) / lutcycle;
+    const auto db = (odd ? (b0 - b1) : (b1 - b0)) / lutcycle;
+    for(; lutpos < static_cast<unsigned>(iterations); ++lutpos) {
+        m_lut[lutpos] = Color::rgba(static_cast<unsigned>(r), static_cast<unsigned>(g), static_cast<unsigned>(b));
+        r += dr;
+        g += dg;
+        b += db;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include "image.h"
+
+#include <vector>
+
+namespace Mandelbrot {
+
+/// Colors of iteration counts, blended back and forth between two colors over
+/// a number of cycles. Points that did not escape are black.
+class Palette {
+public:
+    Palette() = default;
+    Palette(int iterations, int cycles, Color::type from, Color::type to);
+
+    Color::type operator()(int iteration) const {
+        return iteration >= 0 && static_cast<size_t>(iteration) < m_lut.size() ? m_lut[static_cast<size_t>(iteration)] : Color::Black;
+    }
+
+    /// Color a row of iteration counts
+    void apply(const int* iterations, Color::type* row, int width) const {
+        for(auto x = 0; x < width; ++x)
+            row[x] = (*this)(iterations[x]);
+    }
+private:
+    std::vector<Color::type> m_lut;
+};
+
+}
+
+#endif // PALETTE_H
@@ -0,0 +1,131 @@
+#include "pngwriter.h"
+
+#include <zlib.h>
+
+#include <future>
+#include <thread>
+#include <algorithm>
+#include <array>
+
+using namespace Mandelbrot;
+
+static void putU32(unsigned char* p, unsigned long v) {
+    p[0] = static_cast<unsigned char>(v >> 24);
+    p[1] = static_cast<unsigned char>(v >> 16);
+    p[2] = static_cast<unsigned char>(v >> 8);
+    p[3] = static_cast<unsigned char>(v);
+}
+
+PngWriter::PngWriter(std::ostream& out, int width, int height, unsigned threads) :
+    m_out(out), m_width(width), m_height(height),
+    m_threads(threads > 0 ? threads : std::max(1U, std::thread::hardware_concurrency())),
+    m_adler(adler32(0L, Z_NULL, 0)) {
+    const unsigned char signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    m_out.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+    std::array<unsigned char, 13> header;
+    putU32(&header[0], static_cast<unsigned long>(width));
+    putU32(&header[4], static_cast<unsigned long>(height));
+    header[8] = 8;  // bit depth
+    header[9] = 2;  // RGB
+    header[10] = 0; // deflate
+    header[11] = 0; // adaptive filtering
+    header[12] = 0; // no interlace
+    chunk("IHDR", header.data(), header.size());
+    const unsigned char zlibHeader[] = {0x78, 0x9C}; // 32K window, default compression
+    chunk("IDAT", zlibHeader, sizeof(zlibHeader));
+}
+
+void PngWriter::chunk(const char* type, const unsigned char* data, size_t size) {
+    unsigned char buf[4];
+    putU32(buf, static_cast<unsigned long>(size));
+    m_out.write(reinterpret_cast<const char*>(buf), 4);
+    m_out.write(type, 4);
+    m_out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    auto crc = crc32(0L, reinterpret_cast<const Bytef*>(type), 4);
+    if(size > 0) // null data would reset the crc
+        crc = crc32(crc, data, static_cast<uInt>(size));
+    putU32(buf, crc);
+    m_out.write(reinterpret_cast<const char*>(buf), 4);
+}
+
+PngWriter::Group PngWriter::deflate(const Image& rows, int begin, int end, bool last) const {
+    const auto stride = static_cast<size_t>(m_width) * 3 + 1;
+    std::vector<unsigned char> raw(stride * static_cast<size_t>(end - begin));
+    auto p = raw.data();
+    for(auto y = begin; y < end; ++y) {
+        const auto row = rows.row(y);
+        *p++ = 1; // Sub filter, needs only the pixel on the left
+        unsigned char r = 0, g = 0, b = 0;
+        for(auto x = 0; x < m_width; ++x) {
+            const auto c = row[x];
+            const auto cr = static_cast<unsigned char>(Color::r(c));
+            const auto cg = static_cast<unsigned char>(Color::g(c));
+            const auto cb = static_cast<unsigned char>(Color::b(c));
+            *p++ = static_cast<unsigned char>(cr - r);
+            *p++ = static_cast<unsigned char>(cg - g);
+            *p++ = static_cast<unsigned char>(cb - b);
+            r = cr; g = cg; b = cb;
+        }
+    }
+
+    Group group;
+    group.size = raw.size();
+    group.adler = adler32(0L, Z_NULL, 0);
+    group.adler = adler32(group.adler, raw.data(), static_cast<uInt>(raw.size()));
+
+    z_stream zs = {};
+    if(deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) { // raw deflate
+        group.ok = false;
+        return group;
+    }
+    group.data.resize(deflateBound(&zs, static_cast<uLong>(raw.size())) + 16);
+    zs.next_in = raw.data();
+    zs.avail_in = static_cast<uInt>(raw.size());
+    zs.next_out = group.data.data();
+    zs.avail_out = static_cast<uInt>(group.data.size());
+    const auto flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    while(::deflate(&zs, flush) == Z_OK && zs.avail_out == 0) {
+        const auto used = group.data.size();
+        group.data.resize(used * 2);
+        zs.next_out = group.data.data() + used;
+        zs.avail_out = static_cast<uInt>(used);
+    }
+    group.data.resize(zs.total_out);
+    deflateEnd(&zs);
+    return group;
+}
+
+void PngWriter::write(const Image& rows) {
+    if(rows.height() == 0)
+        return;
+    if(m_rows + rows.height() > m_height || rows.width() != m_width) {
+        m_ok = false;
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const auto threads = static_cast<int>(m_threads);
+    const auto groupRows = std::max(MinGroupRows, (rows.height() + threads - 1) / threads);
+    const auto lastRows = m_rows + rows.height() == m_height;
+    std::vector<std::future<Group>> groups;
+    for(auto y = 0; y < rows.height(); y += groupRows) {
+        const auto end = std::min(y + groupRows, rows.height());
+        groups.push_back(std::async(std::launch::async, &PngWriter::deflate, this, std::cref(rows), y, end, lastRows && end == rows.height()));
+    }
+    for(auto& f : groups) {
+        const auto group = f.get();
+        if(!group.ok) {
+            m_ok = false;
+            continue;
+        }
+        m_adler = adler32_combine(m_adler, group.adler, static_cast<z_off_t>(group.size));
+        chunk("IDAT", group.data.data(), group.data.size());
+    }
+    m_rows += rows.height();
+    if(lastRows) {
+        unsigned char adler[4];
+        putU32(adler, m_adler);
+        chunk("IDAT", adler, sizeof(adler));
+        chunk("IEND", nullptr, 0);
+    }
+    m_encodeTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
@@ -0,0 +1,50 @@
+#ifndef PNGWRITER_H
+#define PNGWRITER_H
+
+#if defined(USE_ZLIB)
+
+#include "imagewriter.h"
+#include <chrono>
+
+namespace Mandelbrot {
+
+/// RGB PNG encoder that deflates groups of rows in parallel. Each group is an
+/// independent raw deflate stream ended with a sync flush, so the groups concatenate
+/// into one zlib stream whose Adler-32 is combined from the groups' checksums.
+/// Every group is written as an IDAT chunk of its own as soon as the rows are
+/// encoded, so the image can be streamed a stripe at a time.
+class PngWriter : public ImageWriter {
+public:
+    static constexpr int MinGroupRows = 16;
+
+    /// threads 0 uses all cores
+    PngWriter(std::ostream& out, int width, int height, unsigned threads = 0);
+    void write(const Image& rows) override;
+    bool ok() const override {return m_ok && m_out.good();}
+    /// Time spent in compression and checksums
+    std::chrono::microseconds encodeTime() const {return m_encodeTime;}
+private:
+    struct Group {
+        std::vector<unsigned char> data;
+        unsigned long adler;
+        size_t size;
+        bool ok = true;
+    };
+    Group deflate(const Image& rows, int begin, int end, bool last) const;
+    void chunk(const char* type, const unsigned char* data, size_t size);
+private:
+    std::ostream& m_out;
+    const int m_width;
+    const int m_height;
+    const unsigned m_threads;
+    int m_rows = 0;
+    unsigned long m_adler;
+    bool m_ok = true;
+    std::chrono::microseconds m_encodeTime{0};
+};
+
+}
+
+#endif // USE_ZLIB
+
+#endif // PNGWRITER_H
@@ -0,0 +1,59 @@
+#include "stripedrender.h"
+
+using namespace Mandelbrot;
+
+StripedRender::StripedRender(const std::array<Number, 4>& view, int width, int height, int iterations, int stripeHeight, Setup setup) :
+    m_left(view[0]), m_top(view[1]), m_right(view[2]),
+    m_step((view[3] - view[1]) / Number(height)),
+    m_width(width), m_height(height), m_iterations(iterations),
+    m_stripeHeight(stripeHeight > 0 ? std::min(stripeHeight, height) : height),
+    m_setup(setup) {
+}
+
+std::unique_ptr<StripedRender::Stripe> StripedRender::start(int y) {
+    const auto rows = std::min(m_stripeHeight, m_height - y);
+    auto stripe = std::make_unique<Stripe>();
+    stripe->y = y;
+    stripe->image.create(m_width, rows);
+    stripe->draw = std::make_unique<MandelbrotDraw>(stripe->image,
+                                                    m_left,
+                                                    m_top + m_step * Number(y),
+                                                    m_right,
+                                                    m_top + m_step * Number(y + rows),
+                                                    m_iterations);
+    stripe->draw->setPause(0ms);
+    if(m_setup)
+        m_setup(*stripe->draw);
+    stripe->cached = false;
+    if(m_cache) {
+        const auto guessing = stripe->draw->strategy() == MandelbrotDraw::Strategy::Guessing;
+        stripe->tile = {m_view, m_width, m_height, m_iterations, y, rows, guessing ? "guess" : "exact",
+                        stripe->draw->engine()};
+        FrameBuffer frame;
+        stripe->cached = m_cache->load(stripe->tile, frame) && stripe->draw->show(std::move(frame));
+    }
+    if(!stripe->cached)
+        stripe->draw->update([](int, int) {});
+    return stripe;
+}
+
+bool StripedRender::run(const Sink& sink) {
+    m_stats = {0, 0, 0, 0};
+    auto current = start(0);
+    while(current) {
+        const auto nextY = current->y + current->image.height();
+        auto next = nextY < m_height ? start(nextY) : nullptr;
+        current->draw->wait();
+        if(m_cache && !current->cached)
+            m_cache->store(current->tile, current->draw->frame());
+        const auto s = current->draw->guessStats();
+        m_stats.computed += s.computed;
+        m_stats.guessed += s.guessed;
+        m_stats.corrected += s.corrected;
+        m_stats.reused += s.reused;
+        if(!sink(current->image, current->draw->frame(), current->y))
+            return false;
+        current = std::move(next);
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef STRIPEDRENDER_H
+#define STRIPEDRENDER_H
+
+#include "mandelbrotdraw.h"
+#include "tilecache.h"
+
+#include <memory>
+
+namespace Mandelbrot {
+
+/// Renders a view of any size in horizontal stripes on all cores. Stripes are passed
+/// to the sink in order, and while the sink writes one the next one is calculated,
+/// so memory is bounded by two stripes regardless of the image size.
+class StripedRender {
+public:
+    /// Gets the colors and the iteration data of the stripe, returns false to stop rendering, e.g. on a write error
+    using Sink = std::function<bool (const Image& stripe, const FrameBuffer& frame, int y)>;
+    /// Applied to each stripe before it is calculated, e.g. to set colors
+    using Setup = std::function<void (MandelbrotDraw&)>;
+
+    StripedRender(const std::array<Number, 4>& view, int width, int height, int iterations, int stripeHeight, Setup setup = nullptr);
+
+    /// True if all stripes were rendered and accepted by the sink
+    bool run(const Sink& sink);
+
+    /// Stripes are looked up from the cache before they are calculated and stored
+    /// after, the view is the one given to the constructor as exact strings
+    void setCache(TileCache* cache, const std::array<std::string, 4>& view) {
+        m_cache = cache;
+        m_view = view;
+    }
+
+    /// Sum over all stripes
+    MandelbrotDraw::GuessStats guessStats() const {return m_stats;}
+
+private:
+    struct Stripe {
+        Image image;
+        std::unique_ptr<MandelbrotDraw> draw;
+        int y;
+        TileCache::Tile tile;
+        bool cached;
+    };
+    std::unique_ptr<Stripe> start(int y);
+private:
+    const Number m_left, m_top, m_right;
+    const Number m_step;
+    const int m_width;
+    const int m_height;
+    const int m_iterations;
+    const int m_stripeHeight;
+    const Setup m_setup;
+    MandelbrotDraw::GuessStats m_stats = {0, 0, 0, 0};
+    TileCache* m_cache = nullptr;
+    std::array<std::string, 4> m_view;
+};
+
+}
+
+#endif // STRIPEDRENDER_H
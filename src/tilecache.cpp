@@ -0,0 +1,117 @@
+#include "tilecache.h"
+#include "iterationdata.h"
+#include "mandelbrot.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace Mandelbrot;
+namespace fs = std::filesystem;
+
+static constexpr auto Extension = ".mbit";
+
+std::string TileCache::Tile::key() const {
+    // no string streams, with APML their operator<< is ambiguous with the int_precision shift
+    auto text = engine + '\n';
+    for(const auto& v : view)
+        text += v + '\n';
+    text += std::to_string(width) + 'x' + std::to_string(height) + '\n' + std::to_string(iterations) + '\n'
+            + std::to_string(y) + '+' + std::to_string(rows) + '\n' + variant;
+    // FNV-1a, the tile is verified against its header when loaded
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(const auto c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    char out[17];
+    std::snprintf(out, sizeof(out), "%016llx", static_cast<unsigned long long>(hash));
+    return out;
+}
+
+TileCache::TileCache(const std::string& directory, uintmax_t maxBytes) : m_directory(directory), m_maxBytes(maxBytes) {
+    std::error_code ec;
+    fs::create_directories(m_directory, ec);
+    m_ok = fs::is_directory(m_directory, ec);
+}
+
+std::string TileCache::path(const Tile& tile) const {
+    return (fs::path(m_directory) / (tile.key() + Extension)).string();
+}
+
+bool TileCache::load(const Tile& tile, FrameBuffer& frame) {
+    const auto file = path(tile);
+    IterationData data;
+    if(!m_ok || !data.open(file) || data.view() != tile.view || data.width() != tile.width
+            || data.height() != tile.rows || data.maxIterations() != tile.iterations) {
+        ++m_stats.misses;
+        return false;
+    }
+    frame.resize(data.width(), data.height());
+    const auto size = static_cast<size_t>(data.width()) * static_cast<size_t>(data.height());
+    std::copy_n(data.iterations(0), size, frame.iterations(0));
+    std::copy_n(data.fractions(0), size, frame.fractions(0));
+    std::fill_n(frame.flags(0), size, FrameBuffer::Cached);
+    std::error_code ec;
+    fs::last_write_time(file, fs::file_time_type::clock::now(), ec); // recently used
+    ++m_stats.hits;
+    return true;
+}
+
+void TileCache::store(const Tile& tile, const FrameBuffer& frame) {
+    if(!m_ok)
+        return;
+    const auto file = path(tile);
+    const auto temp = file + '.' + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        IterationWriter writer(temp, tile.view, frame.width(), frame.height(), tile.iterations);
+        writer.write(frame);
+        if(!writer.ok()) {
+            std::error_code ec;
+            fs::remove(temp, ec);
+            return;
+        }
+    }
+    // readers in other processes see either the whole tile or nothing
+    std::error_code ec;
+    fs::rename(temp, file, ec);
+    if(ec)
+        fs::remove(temp, ec);
+    evict();
+}
+
+void TileCache::evict() {
+    struct Entry {
+        fs::path path;
+        uintmax_t size;
+        fs::file_time_type time;
+    };
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+    std::error_code ec;
+    for(const auto& e : fs::directory_iterator(m_directory, ec)) {
+        if(e.path().extension() != Extension)
+            continue;
+        const auto size = e.file_size(ec);
+        if(ec)
+            continue;
+        const auto time = e.last_write_time(ec);
+        if(ec)
+            continue;
+        entries.push_back({e.path(), size, time});
+        total += size;
+    }
+    if(total <= m_maxBytes)
+        return;
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {return a.time < b.time;});
+    for(const auto& e : entries) {
+        if(total <= m_maxBytes)
+            break;
+        if(fs::remove(e.path, ec)) {
+            total -= e.size;
+            ++m_stats.evicted;
+        }
+    }
+}
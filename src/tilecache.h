@@ -0,0 +1,58 @@
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include "framebuffer.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace Mandelbrot {
+
+/// Content addressed cache of iteration data on a local disk, shared between sessions.
+/// A tile is named by a hash of everything its values depend on, and the least recently
+/// used tiles are removed when the cache grows over its size limit.
+class TileCache {
+public:
+    /// Rows [y, y + rows) of a view rendered in the given size
+    struct Tile {
+        std::array<std::string, 4> view;    // left, top, right, bottom exactly as given
+        int width;
+        int height;
+        int iterations;
+        int y;
+        int rows;
+        std::string variant;                // e.g. the strategy, if it changes the values
+        std::string engine;                 // the pixels are iterated in, e.g. MandelbrotDraw::engine()
+        /// Hash of the tile and the number engine
+        std::string key() const;
+    };
+
+    struct Stats {
+        unsigned hits;
+        unsigned misses;
+        unsigned evicted;
+    };
+
+    TileCache(const std::string& directory, uintmax_t maxBytes);
+
+    bool ok() const {return m_ok;}
+
+    /// True if the tile was found, the frame is then filled with its data
+    bool load(const Tile& tile, FrameBuffer& frame);
+    void store(const Tile& tile, const FrameBuffer& frame);
+
+    Stats stats() const {return m_stats;}
+private:
+    std::string path(const Tile& tile) const;
+    void evict();
+private:
+    const std::string m_directory;
+    const uintmax_t m_maxBytes;
+    bool m_ok = false;
+    Stats m_stats = {0, 0, 0};
+};
+
+}
+
+#endif // TILECACHE_H
@@ -0,0 +1,83 @@
+#include "tilepyramid.h"
+
+using namespace Mandelbrot;
+
+TilePyramid::TilePyramid(const std::array<Number, 4>& view, int levels, int tileSize, int iterations, Setup setup) :
+    m_left(view[0]), m_top(view[1]), m_right(view[2]), m_bottom(view[3]),
+    m_levels(levels), m_tileSize(tileSize), m_iterations(iterations), m_setup(setup) {
+}
+
+size_t TilePyramid::tiles() const {
+    size_t count = 0;
+    for(auto z = 0; z < m_levels; ++z)
+        count += size_t(1) << (2 * z);
+    return count;
+}
+
+std::vector<Number> TilePyramid::edges(const Number& start, const Number& end, int count) {
+    std::vector<Number> out;
+    out.reserve(static_cast<size_t>(count) + 1);
+    const auto step = (end - start) / Number(count);
+    for(auto i = 0; i < count; ++i)
+        out.push_back(start + step * Number(i));
+    out.push_back(end);
+    return out;
+}
+
+bool TilePyramid::render(const Level& level, int z, int x, int y, const Sink& sink) const {
+    Image image(m_tileSize, m_tileSize);
+    MandelbrotDraw draw(image,
+                        level.xs[static_cast<size_t>(x)], level.ys[static_cast<size_t>(y)],
+                        level.xs[static_cast<size_t>(x) + 1], level.ys[static_cast<size_t>(y) + 1],
+                        m_iterations, level.xStep, level.yStep);
+    draw.setPause(0ms);
+    draw.setThreads(1);
+    if(m_setup)
+        m_setup(draw);
+    draw.update([](int, int) {});
+    draw.wait();
+    return sink(image, z, x, y);
+}
+
+bool TilePyramid::run(const Sink& sink, unsigned threads) {
+    if(threads == 0)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<Level> levels;
+    for(auto z = 0; z < m_levels; ++z) {
+        const auto count = 1 << z;
+        const Number pixels(count * m_tileSize);
+        levels.push_back({edges(m_left, m_right, count), edges(m_top, m_bottom, count),
+                          (m_right - m_left) / pixels, (m_bottom - m_top) / pixels});
+    }
+
+    // tile n of the whole pyramid, levels in order so that the coarse ones are ready first
+    const auto total = tiles();
+    std::atomic<size_t> next{0};
+    std::atomic_bool ok{true};
+    m_rendered = 0;
+    const ThreadSettings settings;
+    const auto worker = [&]() {
+        settings.apply();
+        for(auto n = next++; n < total && ok; n = next++) {
+            auto z = 0;
+            auto index = n;
+            while(index >= (size_t(1) << (2 * z))) {
+                index -= size_t(1) << (2 * z);
+                ++z;
+            }
+            const auto count = size_t(1) << z;
+            const auto x = static_cast<int>(index % count);
+            const auto y = static_cast<int>(index / count);
+            if(!render(levels[static_cast<size_t>(z)], z, x, y, sink))
+                ok = false;
+            else
+                ++m_rendered;
+        }
+    };
+    std::vector<std::future<void>> workers;
+    for(auto t = 0U; t < threads; ++t)
+        workers.push_back(std::async(std::launch::async, worker));
+    for(auto& w : workers)
+        w.wait();
+    return ok;
+}
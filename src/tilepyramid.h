@@ -0,0 +1,51 @@
+#ifndef TILEPYRAMID_H
+#define TILEPYRAMID_H
+
+#include "mandelbrotdraw.h"
+
+#include <atomic>
+#include <vector>
+
+namespace Mandelbrot {
+
+/// Renders a view as a pyramid of square tiles for web maps: level z splits the view
+/// into 2^z x 2^z tiles, x grows to the right and y downwards. Tiles of all levels are
+/// taken from one queue by a worker per core, each tile on a single thread.
+class TilePyramid {
+public:
+    /// Gets a finished tile, called from the workers concurrently, returns false to stop
+    using Sink = std::function<bool (const Image& tile, int z, int x, int y)>;
+    using Setup = std::function<void (MandelbrotDraw&)>;
+
+    TilePyramid(const std::array<Number, 4>& view, int levels, int tileSize, int iterations, Setup setup = nullptr);
+
+    /// Levels [0, levels), true if all tiles were accepted by the sink
+    bool run(const Sink& sink, unsigned threads = 0);
+
+    /// Tiles in all levels
+    size_t tiles() const;
+    size_t rendered() const {return m_rendered;}
+
+private:
+    /// Tile edges and pixel steps of a level, shared by all of its tiles so that neighbours
+    /// meet exactly and the steps are divided once per level
+    struct Level {
+        std::vector<Number> xs;
+        std::vector<Number> ys;
+        Number xStep;
+        Number yStep;
+    };
+    static std::vector<Number> edges(const Number& start, const Number& end, int count);
+    bool render(const Level& level, int z, int x, int y, const Sink& sink) const;
+private:
+    const Number m_left, m_top, m_right, m_bottom;
+    const int m_levels;
+    const int m_tileSize;
+    const int m_iterations;
+    const Setup m_setup;
+    std::atomic<size_t> m_rendered{0};
+};
+
+}
+
+#endif // TILEPYRAMID_H
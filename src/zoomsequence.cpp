@@ -0,0 +1,76 @@
+#include "zoomsequence.h"
+
+using namespace Mandelbrot;
+
+ZoomSequence::ZoomSequence(const Number& re, const Number& im, const Number& radius, int width, int height, int iterations, int factor, Setup setup) :
+    m_re(re), m_im(im), m_radius(radius), m_width(width), m_height(height), m_iterations(iterations),
+    m_factor(std::max(2, factor)), m_setup(setup) {
+}
+
+FrameBuffer ZoomSequence::seed(const FrameBuffer& previous) const {
+    FrameBuffer out;
+    out.resize(m_width, m_height);
+    const auto source = [this](int p, int size) {
+        const auto twice = 2 * p + (m_factor - 1) * size;
+        return twice % (2 * m_factor) == 0 ? twice / (2 * m_factor) : -1;
+    };
+    for(auto y = 0; y < m_height; ++y) {
+        const auto sy = source(y, m_height);
+        if(sy < 0)
+            continue;
+        for(auto x = 0; x < m_width; ++x) {
+            const auto sx = source(x, m_width);
+            if(sx < 0)
+                continue;
+            out.iterations(y)[x] = previous.iteration(sx, sy);
+            out.fractions(y)[x] = previous.fraction(sx, sy);
+            out.flags(y)[x] = FrameBuffer::Computed;
+        }
+    }
+    return out;
+}
+
+std::unique_ptr<ZoomSequence::Frame> ZoomSequence::start(int index, const Number& radius, const FrameBuffer* previous) const {
+    auto frame = std::make_unique<Frame>();
+    frame->index = index;
+    frame->image.create(m_width, m_height);
+    const auto vertical = radius * Number(m_height) / Number(m_width);
+    frame->draw = std::make_unique<MandelbrotDraw>(frame->image,
+                                                   m_re - radius,
+                                                   m_im - vertical,
+                                                   m_re + radius,
+                                                   m_im + vertical,
+                                                   m_iterations);
+    frame->draw->setPause(0ms);
+    if(m_setup)
+        m_setup(*frame->draw);
+    if(previous)
+        frame->draw->setSeed(seed(*previous));
+    frame->draw->update([](int, int) {});
+    return frame;
+}
+
+bool ZoomSequence::run(int frames, const Sink& sink) {
+    m_stats = {0, 0, 0, 0};
+    if(frames <= 0)
+        return true;
+    auto radius = m_radius;
+    auto current = start(0, radius, nullptr);
+    while(current) {
+        current->draw->wait();
+        const auto s = current->draw->guessStats();
+        m_stats.computed += s.computed;
+        m_stats.guessed += s.guessed;
+        m_stats.corrected += s.corrected;
+        m_stats.reused += s.reused;
+        std::unique_ptr<Frame> next;
+        if(current->index + 1 < frames) {
+            radius = radius / Number(m_factor);
+            next = start(current->index + 1, radius, &current->draw->frame());
+        }
+        if(!sink(current->image, current->index))
+            return false;
+        current = std::move(next);
+    }
+    return true;
+}
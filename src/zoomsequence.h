@@ -0,0 +1,52 @@
+#ifndef ZOOMSEQUENCE_H
+#define ZOOMSEQUENCE_H
+
+#include "mandelbrotdraw.h"
+
+#include <memory>
+
+namespace Mandelbrot {
+
+/// Frames zooming into a center by an integer factor per frame. The center and the
+/// radius are kept in full precision over the whole sequence, pixels of a frame that
+/// coincide with pixels of the previous one are taken from it, and the next frame is
+/// calculated while the sink encodes the current one.
+class ZoomSequence {
+public:
+    /// Gets frames in order, returns false to stop
+    using Sink = std::function<bool (const Image& frame, int index)>;
+    using Setup = std::function<void (MandelbrotDraw&)>;
+
+    /// Radius is half of the first frame width
+    ZoomSequence(const Number& re, const Number& im, const Number& radius, int width, int height, int iterations, int factor, Setup setup = nullptr);
+
+    bool run(int frames, const Sink& sink);
+
+    /// Sum over all frames
+    MandelbrotDraw::GuessStats guessStats() const {return m_stats;}
+
+private:
+    struct Frame {
+        Image image;
+        std::unique_ptr<MandelbrotDraw> draw;
+        int index;
+    };
+    std::unique_ptr<Frame> start(int index, const Number& radius, const FrameBuffer* previous) const;
+    /// Pixels of the previous frame at the positions of the next one, pixel x of the next frame
+    /// is pixel (x + (factor - 1) * width / 2) / factor of the previous if that is an integer
+    FrameBuffer seed(const FrameBuffer& previous) const;
+private:
+    const Number m_re;
+    const Number m_im;
+    const Number m_radius;
+    const int m_width;
+    const int m_height;
+    const int m_iterations;
+    const int m_factor;
+    const Setup m_setup;
+    MandelbrotDraw::GuessStats m_stats = {0, 0, 0, 0};
+};
+
+}
+
+#endif // ZOOMSEQUENCE_H